@@ -19,6 +19,8 @@ class wxEvtHandler;
 
 namespace wex
 {
+class find_pool;
+
 /// Offers find_files method.
 /// By overriding on_dir and on_file you can take care
 /// of what to do with the result.
@@ -62,7 +64,8 @@ public:
   /// Finds matching files.
   /// This results in recursive calls for on_dir and on_file.
   /// Runs as a separate thread if event handler is setup,
-  /// otherwise runs synchronized.
+  /// otherwise runs synchronized. A find tool is run on the files
+  /// by a pool of threads, see data::dir::threads.
   /// Returns 1 if thread is started, or number of matches
   /// for synchronized runs.
   /// You can set a limit on retrieving files by setting
@@ -91,6 +94,8 @@ private:
   const data::dir m_data;
   wxEvtHandler*   m_eh{nullptr};
   wex::tool       m_tool;
+
+  mutable find_pool* m_pool{nullptr};
 };
 
 /// Returns all matching files into a vector of strings (without paths).
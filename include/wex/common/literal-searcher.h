@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      literal-searcher.h
+// Purpose:   Declaration of class wex::literal_searcher
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace wex
+{
+/// Offers a searcher for a literal text, to be used on many texts.
+/// Candidates are found by comparing the first and last char of the
+/// text on blocks of chars (using SSE2 or AVX2 if available),
+/// and then verified. Case folding is ASCII only.
+class literal_searcher
+{
+public:
+  /// Callback for a match, return false to stop searching.
+  typedef std::function<bool(size_t pos)> match_t;
+
+  /// Constructor.
+  literal_searcher(
+    /// the text to search for
+    const std::string& text,
+    /// whether to match case
+    bool match_case = true,
+    /// whether to match whole words only
+    bool match_word = false);
+
+  /// Returns true if there is no text to search for.
+  bool empty() const { return m_text.empty(); }
+
+  /// Returns pos of first match in text starting at pos start,
+  /// or std::string::npos.
+  size_t find(std::string_view text, size_t start = 0) const;
+
+  /// Invokes callback for every (non overlapping) match in text.
+  /// Returns number of matches.
+  size_t find_all(std::string_view text, const match_t& f) const;
+
+  /// Returns size of the text to search for.
+  size_t size() const { return m_text.size(); }
+
+private:
+  bool   equal(const char* s) const;
+  size_t find_candidate(std::string_view text, size_t start) const;
+  bool   is_word(std::string_view text, size_t pos) const;
+
+  std::string m_text; // folded if not match case
+
+  const bool m_match_case, m_match_word;
+
+  // Or masks for the first and last char, to fold them.
+  char m_first_mask{0}, m_last_mask{0};
+};
+}; // namespace wex
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      match-ring.h
+// Purpose:   Declaration of class wex::match_ring
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wex/common/path-match.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+class wxEvtHandler;
+
+namespace wex
+{
+/// Offers a bounded ring buffer to deliver matches from a find thread
+/// to the event handler that shows them, e.g. a listview.
+/// The producers are serialized, the consumer takes matches without locking.
+/// If the ring is full, a producer waits until the consumer has taken
+/// matches, so memory stays bounded if the consumer falls behind.
+class match_ring
+{
+public:
+  /// The callback invoked by a producer after pushing a match,
+  /// if the consumer was not yet notified since it last took matches.
+  /// It is invoked from the producer thread.
+  typedef std::function<void()> notify_t;
+
+  /// The callback invoked for each match taken.
+  typedef std::function<void(const path_match&)> take_t;
+
+  /// Returns the ring for the event handler,
+  /// or nullptr if the event handler has no ring.
+  static std::shared_ptr<match_ring> get(wxEvtHandler* eh);
+
+  /// Sets the ring for the event handler.
+  /// A previous ring is closed, a nullptr only removes it.
+  static void set(wxEvtHandler* eh, std::shared_ptr<match_ring> ring);
+
+  /// Constructor, the capacity is rounded up to a power of two.
+  match_ring(size_t capacity, notify_t notify);
+
+  /// Returns capacity.
+  size_t capacity() const { return m_slots.size(); }
+
+  /// Closes the ring, waiting producers return,
+  /// and next matches are discarded.
+  void close();
+
+  /// Returns true if the ring is empty.
+  bool empty() const { return size() == 0; }
+
+  /// Pushes a match, waits while the ring is full.
+  /// Returns false if the ring is closed.
+  bool push(const path_match& m);
+
+  /// Returns number of matches in the ring.
+  size_t size() const { return m_tail.load() - m_head.load(); }
+
+  /// Takes at most max matches, invoking f for each match.
+  /// Returns number of matches taken.
+  size_t take(const take_t& f, size_t max = std::string::npos);
+
+private:
+  const notify_t m_notify;
+
+  std::vector<std::optional<path_match>> m_slots;
+
+  alignas(64) std::atomic<size_t> m_head{0};
+  alignas(64) std::atomic<size_t> m_tail{0};
+
+  std::atomic<bool> m_closed{false}, m_notified{false};
+
+  std::mutex              m_mutex;
+  std::condition_variable m_space;
+};
+}; // namespace wex
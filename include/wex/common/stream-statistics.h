@@ -10,72 +10,226 @@
 #include <wex/common/statistics.h>
 #include <wx/translation.h>
 
+#include <array>
+#include <atomic>
+#include <mutex>
+
 namespace wex
 {
 /// Offers specific statistics used by dir and stream.
+/// The statistics used by dir and stream are kept in fixed atomic
+/// counters, other keys are kept in a statistics extension.
+/// All methods are thread safe.
 class stream_statistics
 {
 public:
-  /// Adds other statistics.
-  stream_statistics& operator+=(const stream_statistics& s)
+  /// The fixed counters.
+  enum key_t
   {
-    m_elements += s.m_elements;
-    return *this;
-  }
+    ACTIONS,           ///< files
+    ACTIONS_COMPLETED, ///< actions completed
+    FOLDERS,           ///< folders
+    KEY_MAX,           ///< number of counters
+  };
+
+  /// Returns the (translated) name of a counter.
+  static const std::string name(key_t key);
+
+  /// Default constructor.
+  stream_statistics() = default;
+
+  /// Copy constructor.
+  stream_statistics(const stream_statistics& s) { *this += s; }
+
+  /// Assignment operator.
+  stream_statistics& operator=(const stream_statistics& s);
+
+  /// Adds other statistics.
+  stream_statistics& operator+=(const stream_statistics& s);
 
   /// Clears the statistics.
-  void clear() { m_elements.clear(); }
+  void clear();
 
   /// Returns true if statistics are empty.
-  bool empty() const { return m_elements.empty(); }
+  bool empty() const;
 
   /// Returns all items as a string. All items are returned as a string,
   /// with newlines separating items.
-  const std::string get() const { return m_elements.get(); }
+  const std::string get() const { return get_elements().get(); }
 
   /// Returns the key, if not present 0 is returned.
   int get(const std::string& key) const;
 
-  /// Returns the elements.
-  const statistics<int>& get_elements() const { return m_elements; }
+  /// Returns the counter.
+  int get(key_t key) const { return m_counters[key].load(); }
 
-  /// Returns the elements.
-  statistics<int>& get_elements() { return m_elements; }
+  /// Returns a copy of all elements, the counters that are set
+  /// and the extension.
+  const statistics<int> get_elements() const;
 
   /// Increments keyword. Returns value.
   int inc(const std::string& keyword, int inc_value = 1);
 
+  /// Increments counter. Returns value.
+  int inc(key_t key, int inc_value = 1)
+  {
+    return m_counters[key].fetch_add(inc_value) + inc_value;
+  }
+
   /// Increments actions. Returns value.
-  int inc_actions();
+  int inc_actions() { return inc(ACTIONS); }
 
   /// Increments actions completed. Returns value.
-  int inc_actions_completed(int inc_value = 1);
+  int inc_actions_completed(int inc_value = 1)
+  {
+    return inc(ACTIONS_COMPLETED, inc_value);
+  }
 
 private:
-  statistics<int> m_elements;
+  /// Returns the counter for the name, or KEY_MAX.
+  static key_t find(const std::string& key);
+
+  std::array<std::atomic<int>, KEY_MAX> m_counters{};
+
+  mutable std::mutex m_mutex;
+  statistics<int>    m_elements;
 };
 
 // implementation
 
+inline const std::string wex::stream_statistics::name(key_t key)
+{
+  switch (key)
+  {
+    case ACTIONS:
+      return _("Files").ToStdString();
+
+    case ACTIONS_COMPLETED:
+      return _("Actions Completed").ToStdString();
+
+    case FOLDERS:
+      return _("Folders").ToStdString();
+
+    default:
+      return std::string();
+  }
+}
+
+inline wex::stream_statistics&
+wex::stream_statistics::operator=(const stream_statistics& s)
+{
+  if (this != &s)
+  {
+    clear();
+    *this += s;
+  }
+
+  return *this;
+}
+
+inline wex::stream_statistics&
+wex::stream_statistics::operator+=(const stream_statistics& s)
+{
+  for (int i = 0; i < KEY_MAX; i++)
+  {
+    m_counters[i] += s.m_counters[i].load();
+  }
+
+  statistics<int> elements;
+
+  {
+    std::lock_guard<std::mutex> lock(s.m_mutex);
+    elements = s.m_elements;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_elements += elements;
+
+  return *this;
+}
+
+inline void wex::stream_statistics::clear()
+{
+  for (auto& c : m_counters)
+  {
+    c = 0;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_elements.clear();
+}
+
+inline bool wex::stream_statistics::empty() const
+{
+  if (!std::ranges::all_of(
+        m_counters,
+        [](const auto& c)
+        {
+          return c.load() == 0;
+        }))
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_elements.empty();
+}
+
+inline wex::stream_statistics::key_t
+wex::stream_statistics::find(const std::string& key)
+{
+  for (int i = 0; i < KEY_MAX; i++)
+  {
+    if (key == name(static_cast<key_t>(i)))
+    {
+      return static_cast<key_t>(i);
+    }
+  }
+
+  return KEY_MAX;
+}
+
 inline int wex::stream_statistics::get(const std::string& key) const
 {
+  if (const auto k(find(key)); k != KEY_MAX)
+  {
+    return get(k);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
   const auto it = m_elements.get_items().find(key);
   return (it != m_elements.get_items().end() ? it->second : 0);
 }
 
-inline int
-wex::stream_statistics::inc(const std::string& keyword, int inc_value)
+inline const wex::statistics<int> wex::stream_statistics::get_elements() const
 {
-  return m_elements.inc(keyword, inc_value);
-}
+  statistics<int> elements;
 
-inline int wex::stream_statistics::inc_actions()
-{
-  return inc(_("Files").ToStdString());
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    elements = m_elements;
+  }
+
+  for (int i = 0; i < KEY_MAX; i++)
+  {
+    if (const auto value(m_counters[i].load()); value != 0)
+    {
+      elements.set(name(static_cast<key_t>(i)), value);
+    }
+  }
+
+  return elements;
 }
 
-inline int wex::stream_statistics::inc_actions_completed(int inc_value)
+inline int
+wex::stream_statistics::inc(const std::string& keyword, int inc_value)
 {
-  return inc(_("Actions Completed").ToStdString(), inc_value);
+  if (const auto k(find(keyword)); k != KEY_MAX)
+  {
+    return inc(k, inc_value);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_elements.inc(keyword, inc_value);
 }
 }; // namespace wex
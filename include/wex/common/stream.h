@@ -7,10 +7,16 @@
 
 #pragma once
 
+#include <wex/common/literal-searcher.h>
 #include <wex/common/stream-statistics.h>
 #include <wex/common/tool.h>
+#include <wex/core/regex-substitute.h>
 #include <wex/syntax/path-lexer.h>
 
+#include <functional>
+#include <optional>
+#include <string_view>
+
 class wxEvtHandler;
 
 namespace wex
@@ -20,10 +26,15 @@ namespace factory
 class find_replace_data;
 };
 
+class path_match;
+
 /// Adds run_tool methods and statistics to a file stream.
 class stream
 {
 public:
+  /// Callback for a match.
+  typedef std::function<void(const path_match&)> match_t;
+
   /// Constructor.
   stream(
     wex::factory::find_replace_data* frd,
@@ -43,11 +54,26 @@ public:
   /// Runs the tool.
   bool run_tool();
 
-private:
-  bool is_word_character(int c) const { return isalnum(c) || c == '_'; }
+  /// Stops run_tool as soon as interruptible is no longer running.
+  void use_interruptible(bool use = true) { m_interruptible = use; }
+
+  /// Uses callback for matches, instead of posting them
+  /// to the event handler.
+  void use_match(const match_t& f) { m_match = f; }
+
+  /// Asks to continue if the max replacements are exceeded (default).
+  /// Pooled streams do not ask, these are cancelled by interruptible.
+  void use_prompt(bool use = true) { m_prompt = use; }
 
+private:
   bool process(std::string& text, size_t line_no);
   bool process_begin();
+  bool
+  process_match(const std::string& text, size_t line_no, int pos, int count);
+
+  bool run_lines(std::string_view text);
+  bool run_searcher(std::string_view text);
+  bool write(const std::string& text) const;
 
   int replace_all(std::string& text, int* match_pos);
 
@@ -58,12 +84,19 @@ private:
   stream_statistics m_stats;
   int               m_prev{0};
 
-  bool m_modified{false}, m_write{false};
+  bool m_asked{false}, m_interruptible{false}, m_modified{false},
+    m_prompt{true}, m_write{false};
+
+  match_t m_match;
+
+  // Compiled once in process_begin, for regex replace.
+  std::optional<regex_substitute> m_substitute;
+
+  // Built once in process_begin, for find without regex.
+  std::optional<literal_searcher> m_searcher;
 
   wxEvtHandler* m_eh{nullptr};
 
   wex::factory::find_replace_data* m_frd;
-  std::string                      m_find_string;
-  static inline bool               m_asked{false};
 };
 }; // namespace wex
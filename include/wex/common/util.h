@@ -145,6 +145,8 @@ int open_files(
   const data::dir::type_t& type = data::dir::type_t_def());
 
 /// Processes a match.
+/// From a find thread, the match is pushed on the match_ring of
+/// the event handler if it has one, otherwise an event is posted.
 void process_match(
   /// the match path
   const path_match& m,
@@ -10,6 +10,8 @@
 #include <wx/app.h>
 #include <wx/uilocale.h>
 
+#include <functional>
+
 namespace wex
 {
 /// Offers the application, with lib specific init and exit,
@@ -20,6 +22,10 @@ class app : public wxApp
 public:
   // Static interface.
 
+  /// Adds a callback invoked by OnExit, before the config is saved,
+  /// e.g. to save data of other libs that is kept in memory.
+  static void add_exit(std::function<void()> f);
+
   /// Returns the locale.
   static const wxUILocale& get_locale();
 
@@ -69,6 +69,20 @@ const std::string find_tail(const std::string& text, size_t max_chars = 15);
 /// If text is empty, 0 is returned, otherwise at least 1.
 size_t get_number_of_lines(const std::string& text, bool trimmed = false);
 
+/// Appends strings from set to text, using a space separator.
+/// Only the strings starting with prefix are visited, so text can be
+/// used as a reused buffer for completion.
+/// Returns number of strings appended.
+size_t append_string_set(
+  /// the text to append to
+  std::string& text,
+  /// the set to use
+  const std::set<std::string>& kset,
+  /// only add string from set if its size is at least min_size
+  size_t min_size = 0,
+  /// only add string from set if it starts with the prefix
+  const std::string& prefix = std::string());
+
 /// Returns string from set, using a space separator.
 const std::string get_string_set(
   /// the set to use
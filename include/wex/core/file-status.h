@@ -37,6 +37,9 @@ public:
     /// the format as used by std::put_time
     const std::string& format = TIME_FORMAT) const;
 
+  /// Returns the inode, changes if the file is replaced.
+  ino_t get_inode() const;
+
   /// Returns modification time.
   time_t get_modification_time() const;
 
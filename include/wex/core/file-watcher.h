@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      file-watcher.h
+// Purpose:   Declaration of class wex::file_watcher
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wex/core/path.h>
+
+#include <functional>
+#include <vector>
+
+namespace wex
+{
+/// Offers a central file watcher, that watches paths using inotify.
+/// Changes are coalesced, and delivered to the subscribers
+/// on the main thread.
+/// If watching is not supported, subscribe returns 0, and the subscriber
+/// should check for changes itself (e.g. file::check_sync on a timer).
+/// A watched dir that is removed is watched again when present.
+class file_watcher
+{
+public:
+  /// The callback invoked on the main thread for a changed path.
+  typedef std::function<void(const path&)> changed_t;
+
+  /// Adds a path to watch to the subscription.
+  /// Returns false if subscription is not present, or if the path
+  /// could not be watched (e.g. at the inotify watch limit), then the
+  /// subscriber should check for changes itself.
+  static bool add(size_t id, const path& p);
+
+  /// Removes all paths from the subscription.
+  static void clear(size_t id);
+
+  /// Returns true if watching is supported.
+  static bool is_supported();
+
+  /// Returns the path as delivered to the subscribers,
+  /// absolute and with symlinks resolved.
+  static path normal(const path& p);
+
+  /// Stops watching, invoked by app::OnExit.
+  static void on_exit();
+
+  /// Sets the paths to watch for the subscription, paths
+  /// watched before and not present are no longer watched.
+  /// Returns false if subscription is not present, or if
+  /// not all paths could be watched.
+  static bool set(size_t id, const std::vector<path>& v);
+
+  /// Subscribes, returns the subscription id,
+  /// or 0 if watching is not supported.
+  static size_t subscribe(changed_t f);
+
+  /// Unsubscribes, the callback is no longer invoked.
+  static void unsubscribe(size_t id);
+};
+}; // namespace wex
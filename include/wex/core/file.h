@@ -10,6 +10,7 @@
 #include <wex/core/path.h>
 
 #include <fstream>
+#include <functional>
 #include <istream>
 #include <memory>
 #include <span>
@@ -42,8 +43,8 @@ public:
   /// Copy constructor.
   file(const file& rhs);
 
-  /// Destructor.
-  virtual ~file() = default;
+  /// Destructor, stops watching.
+  virtual ~file();
 
   /// Assignment operator.
   file& operator=(const file& f);
@@ -71,6 +72,9 @@ public:
   /// Returns true if file is open.
   bool is_open() const { return m_fs.is_open(); }
 
+  /// Returns true if file is watched.
+  bool is_watched() const { return m_watch_id != 0; }
+
   /// Returns true if file has been written.
   bool is_written() const { return m_is_written; }
 
@@ -99,6 +103,15 @@ public:
   /// call this method, stream remains open.
   void use_stream(bool use = true) { m_use_stream = use; }
 
+  /// Watches the path using the file_watcher, the callback is invoked
+  /// on the main thread if the file changed, e.g. to invoke check_sync.
+  /// If the path changes the new path is watched, if that fails
+  /// the file is no longer watched (see is_watched).
+  /// A nullptr callback stops watching.
+  /// Returns false if watching is not supported or failed, then
+  /// you should invoke check_sync once in a while.
+  bool watch(std::function<void()> f);
+
   /// Writes file from buffer.
   bool write(std::span<const char> buffer);
 
@@ -137,6 +150,8 @@ private:
 
   bool m_is_loaded{false}, m_is_written{false}, m_use_stream{false};
 
+  size_t m_watch_id{0};
+
   wex::path                    m_path, m_path_prev;
   file_status                  m_stat; // used to check for sync
   std::fstream                 m_fs;
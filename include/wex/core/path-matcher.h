@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      path-matcher.h
+// Purpose:   Include file for class wex::path_matcher
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <boost/regex.hpp>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace wex
+{
+/// This class offers matching filenames against a compiled
+/// file spec, like *.cpp;*.h.
+/// Fields like *.cpp are matched using a set of extensions,
+/// other fields using a glob (* matches any, ? matches 0 or 1 char),
+/// or, if the spec is a regex, using compiled regular expressions.
+class path_matcher
+{
+public:
+  /// Constructor.
+  explicit path_matcher(
+    /// the patterns to match, fields separated by ; sign
+    const std::string& patterns = std::string(),
+    /// default the pattern is not a regex, but you can change it
+    bool is_regex = false);
+
+  /// Returns true if there are no patterns.
+  bool empty() const { return m_patterns.empty(); }
+
+  /// Returns true if filename (fullname) matches one of the patterns.
+  bool matches(const std::string& fullname) const;
+
+  /// Returns the patterns.
+  const std::string& patterns() const { return m_patterns; }
+
+private:
+  bool m_all{false};
+
+  std::string m_patterns;
+
+  std::unordered_set<std::string> m_extensions;
+  std::vector<std::string>        m_globs;
+  std::vector<boost::regex>       m_regex;
+};
+}; // namespace wex
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      regex-substitute.h
+// Purpose:   Include file for class wex::regex_substitute
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <boost/regex.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wex
+{
+/// This class offers regular expression substitution, where
+/// the regular expression and the (sed format) replacement
+/// are compiled once, to be used on many texts.
+/// Texts that do not contain the literal prefix of the
+/// regular expression are rejected without running the regex.
+class regex_substitute
+{
+public:
+  /// Constructor, provide regular expression string,
+  /// replacement and flags.
+  regex_substitute(
+    const std::string&      regex,
+    const std::string&      replacement,
+    boost::regex::flag_type flags = boost::regex::ECMAScript);
+
+  /// Constructor, provide compiled regular expression and replacement.
+  regex_substitute(const boost::regex& regex, const std::string& replacement);
+
+  /// Returns true if regular expression is valid.
+  bool is_ok() const { return m_regex.status() == 0; }
+
+  /// Returns the literal prefix used to reject texts.
+  const std::string& prefix() const { return m_prefix; }
+
+  /// Replaces all matches in text, and appends the result to out.
+  /// Returns number of replacements, and sets first match pos
+  /// (if not nullptr and a match was found).
+  int
+  replace(std::string_view text, std::string& out, int* pos = nullptr) const;
+
+  /// Replaces all matches in text.
+  /// Returns number of replacements.
+  int replace(std::string& text, int* pos = nullptr) const;
+
+private:
+  struct part_t
+  {
+    int         group; ///< the submatch, or -1 for literal text
+    std::string text;
+  };
+
+  void compile(const std::string& replacement);
+
+  boost::regex        m_regex;
+  std::string         m_prefix, m_replacement;
+  std::vector<part_t> m_parts;
+  bool                m_format{false};
+};
+}; // namespace wex
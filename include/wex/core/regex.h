@@ -2,7 +2,7 @@
 // Name:      regex.h
 // Purpose:   Include file for class wex::regex
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2021-2025 Anton van Wezenbeek
+// Copyright: (c) 2021-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
@@ -61,6 +61,13 @@ public:
     function_t   m_function{nullptr};
   };
 
+  /// Returns number of compiled regular expressions that were
+  /// taken from the cache.
+  static size_t cache_hits();
+
+  /// Returns number of regular expressions that had to be compiled.
+  static size_t cache_misses();
+
   /// Constructor, provide regular expression data.
   regex(const data&);
 
@@ -14,6 +14,7 @@
 #include <wex/core/config.h>
 #include <wex/core/core.h>
 #include <wex/core/file-status.h>
+#include <wex/core/file-watcher.h>
 #include <wex/core/file.h>
 #include <wex/core/function-repeat.h>
 #include <wex/core/interruptible.h>
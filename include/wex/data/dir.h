@@ -2,11 +2,12 @@
 // Name:      data/dir.h
 // Purpose:   Declaration of class wex::data::dir
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2021-2025 Anton van Wezenbeek
+// Copyright: (c) 2021-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
 
+#include <wex/core/path-matcher.h>
 #include <wex/factory/frd.h>
 #include <wex/factory/vcs.h>
 
@@ -35,24 +36,35 @@ public:
   /// All flags, except HIDDEN are on.
   static type_t type_t_def() { return type_t().set().set(HIDDEN, false); }
 
+  /// Returns the dir matcher, compiled from dir spec.
+  const path_matcher& dir_matcher() const { return m_dir_matcher; }
+
   /// Returns the dir spec.
-  const std::string& dir_spec() const { return m_dir_spec; }
+  const std::string& dir_spec() const { return m_dir_matcher.patterns(); }
 
   /// Sets dir specs.
   dir& dir_spec(const std::string& rhs)
   {
-    m_dir_spec = rhs;
+    m_dir_matcher = path_matcher(rhs, m_is_regex);
     return *this;
   }
 
+  /// Returns the file matcher, compiled from file spec.
+  const path_matcher& file_matcher() const { return m_file_matcher; }
+
   /// Returns the file spec.
-  const std::string& file_spec() const { return m_file_spec; }
+  const std::string& file_spec() const { return m_file_matcher.patterns(); }
 
   /// Sets file specs.
   dir& file_spec(const std::string& rhs, bool is_regex = false)
   {
-    m_file_spec = rhs;
-    m_is_regex  = is_regex;
+    if (m_is_regex != is_regex)
+    {
+      m_is_regex    = is_regex;
+      m_dir_matcher = path_matcher(m_dir_matcher.patterns(), m_is_regex);
+    }
+
+    m_file_matcher = path_matcher(rhs, m_is_regex);
     return *this;
   }
 
@@ -66,6 +78,10 @@ public:
     return *this;
   }
 
+  /// Returns whether matches are delivered in the order
+  /// the files are found, default true.
+  bool is_ordered() const { return m_is_ordered; }
+
   /// Returns whether file_spec is a regex.
   bool is_regex() const { return m_is_regex; }
 
@@ -79,6 +95,25 @@ public:
     return *this;
   }
 
+  /// Sets ordered.
+  dir& ordered(bool rhs)
+  {
+    m_is_ordered = rhs;
+    return *this;
+  }
+
+  /// Returns number of threads that run a find tool on files,
+  /// 0 (default) uses the hardware concurrency, 1 runs the tool
+  /// in the traversing thread.
+  int threads() const { return m_threads; }
+
+  /// Sets threads.
+  dir& threads(int rhs)
+  {
+    m_threads = rhs;
+    return *this;
+  }
+
   /// Returns type.
   type_t type() const { return m_flags; }
 
@@ -103,9 +138,9 @@ private:
   factory::find_replace_data* m_frd{nullptr};
   factory::vcs*               m_vcs{nullptr};
 
-  bool        m_is_regex{false};
-  int         m_max_matches{-1};
-  std::string m_dir_spec, m_file_spec;
-  type_t      m_flags{type_t_def()};
+  bool        m_is_ordered{true}, m_is_regex{false};
+  int         m_max_matches{-1}, m_threads{0};
+  path_matcher m_dir_matcher, m_file_matcher;
+  type_t       m_flags{type_t_def()};
 };
 }; // namespace wex::data
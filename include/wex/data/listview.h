@@ -100,6 +100,14 @@ public:
   listview&
   menu(menu_t flags, data::control::action_t action = data::control::SET);
 
+  /// Returns whether the list is virtual, items are kept in
+  /// a listview_store instead of in the control.
+  bool owner_data() const { return m_is_owner_data; };
+
+  /// Sets owner data member, to use a virtual list (wxLC_VIRTUAL),
+  /// for lists with many items, like find results.
+  listview& owner_data(bool rhs);
+
   /// Returns is revision member.
   bool revision() const { return m_is_revision; };
 
@@ -141,7 +149,7 @@ private:
   image_t m_image_type{IMAGE_ART};
   type_t  m_type{NONE};
 
-  bool m_initialized{false}, m_is_revision{false};
+  bool m_initialized{false}, m_is_owner_data{false}, m_is_revision{false};
 };
 }; // namespace data
 }; // namespace wex
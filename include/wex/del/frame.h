@@ -16,6 +16,7 @@
 #include <wex/ui/file-history.h>
 #include <wex/ui/frame.h>
 #include <wex/ui/item.h>
+#include <wex/vcs/blame-cache.h>
 #include <wex/vcs/vcs.h>
 
 #include <set>
@@ -248,6 +249,8 @@ private:
 
   function_repeat m_function_repeat;
 
+  mutable blame_cache m_blame_cache;
+
   const indicator m_indicator_add = wex::indicator(3);
 
   const std::string m_text_hidden{_("fif.Hidden")},
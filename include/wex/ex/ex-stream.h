@@ -11,6 +11,7 @@
 #include <wex/factory/text-window.h>
 
 #include <fstream>
+#include <memory>
 #include <unordered_map>
 
 namespace wex
@@ -18,7 +19,11 @@ namespace wex
 class address;
 class addressrange;
 class ex;
+class ex_stream_index;
+class ex_stream_line;
+class ex_stream_pieces;
 class file;
+class path;
 
 namespace syntax
 {
@@ -36,6 +41,10 @@ class substitute;
 /// All modifications are done in the temp file, and copied to
 /// the work file upon changing. If you ask for a write,
 /// the work file is copied to the original file.
+/// If the file can be memory mapped, lines are accessed using
+/// a line index, otherwise the stream is used. Then modifications
+/// are kept in a piece table, and only written upon a write, and
+/// can be undone.
 class ex_stream : public factory::text_window
 {
 public:
@@ -79,7 +88,7 @@ public:
   /// Goes to the previous line.
   bool get_previous_line();
 
-  /// Returns content of work file.
+  /// Returns content of work file, or of the piece table.
   const std::string* get_work() const;
 
   /// Inserts text at specified line.
@@ -125,11 +134,17 @@ public:
   /// Returns text value, as result of doing a get_lines.
   const std::string& text() const { return m_text; }
 
+  /// Undoes last modification.
+  /// Returns false if there is nothing to undo.
+  bool undo();
+
   /// Writes working stream to file.
   /// Returns false if internal streams are not valid.
   bool write();
 
   /// Writes range to file.
+  /// If the file is the file itself, the file is loaded again,
+  /// it is no longer modified, and the undo history is cleared.
   /// Returns false if no stream, or range is invalid.
   bool write(
     const addressrange& range,
@@ -154,14 +169,19 @@ private:
   bool copy(file* from, file* to);
   void filter_line(int start, int end, std::streampos spos);
   bool find_finish(const data::find& f, bool& found);
+  void index(const path& p);
+  bool pieces_line(int no);
+  bool pieces_modified(const std::string& message);
+  bool scan(const addressrange& range, ex_stream_line& sl);
   void set_text();
+  void sync_changed();
 
   bool m_block_mode{false}, m_is_modified{false};
 
   const size_t m_buffer_size, m_context_lines;
 
   size_t m_line_size_requested{0}, m_line_size_current{0},
-    m_line_size_default{0};
+    m_line_size_default{0}, m_watch_id{0};
 
   std::fstream* m_stream{nullptr}; // pointer in m_file to actual stream
   file *        m_file{nullptr}, *m_temp{nullptr}, *m_work{nullptr};
@@ -173,10 +193,14 @@ private:
 
   std::unordered_map<char, int> m_markers;
 
+  std::unique_ptr<ex_stream_index>  m_index;
+  std::unique_ptr<ex_stream_pieces> m_pieces; // uses m_index
+
   char* m_buffer{nullptr};
   char* m_current_line{nullptr};
 
-  std::string m_text;
+  std::string         m_text;
+  mutable std::string m_work_text;
 
   syntax::stc* m_stc;
   wex::ex*     m_ex;
@@ -13,9 +13,13 @@
 #include <wex/ex/macro-mode.h>
 #include <wex/ex/variable.h>
 
+#include <memory>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
+class wxTimer;
+
 namespace wex
 {
 class path;
@@ -63,6 +67,9 @@ public:
   /// Default constructor.
   macros();
 
+  /// Destructor.
+  ~macros();
+
   /// Erases current macro from the vector and cleans it.
   /// Returns true if macro was erased.
   bool erase();
@@ -104,8 +111,11 @@ public:
   const variables_map_t& get_variables() const { return m_variables; }
 
   /// Returns true if xml structure has been modified
-  /// without being saved.
-  bool is_modified() const { return m_is_modified; }
+  /// without being saved, or registers have been set since last save.
+  bool is_modified() const
+  {
+    return m_is_modified || !m_registers_modified.empty();
+  }
 
   /// Is macro or variable recorded.
   bool is_recorded(const std::string& macro) const;
@@ -118,6 +128,10 @@ public:
   /// Returns true if document is loaded (macros still can be empty).
   bool load_document();
 
+  /// Saves the document if registers are modified.
+  /// Invoked by app::OnExit, after the document is loaded.
+  void on_exit();
+
   /// Returns the mode we are in.
   macro_mode& mode() { return m_mode; }
 
@@ -142,6 +156,7 @@ public:
     bool new_command = true);
 
   /// Saves all macros (and variables) to xml document.
+  /// Registers set since last save are added to the document first.
   /// If you specify only_if_modified, then document is only saved
   /// if it was modified (if macros have been recorded since last save).
   /// Returns true if document is saved.
@@ -164,7 +179,10 @@ public:
   void set_map(const std::string& name, const std::string& value);
 
   /// Sets register (overwrites existing register).
-  /// The name should be a one letter register.
+  /// The name should be a one letter register, an upper case
+  /// name appends to the register.
+  /// The register is kept in memory, the document is saved after
+  /// a delay, so setting many registers results in one save.
   /// Returns false if name is not appropriate.
   bool set_register(char name, const std::string& value);
 
@@ -177,6 +195,8 @@ public:
 private:
   bool load_document_init();
 
+  bool macro_to_document(const std::string& macro);
+
   template <typename S, typename T>
   void
   parse_node(const pugi::xml_node& node, const std::string& name, T& container);
@@ -191,7 +211,7 @@ private:
     const std::string& name,
     const std::string& value);
 
-  bool m_is_loaded{false}, m_is_modified{false};
+  bool m_is_exit_added{false}, m_is_loaded{false}, m_is_modified{false};
 
   pugi::xml_document m_doc;
 
@@ -206,6 +226,10 @@ private:
 
   keys_map_t m_map_alt_keys, m_map_control_keys, m_map_keys;
 
+  std::set<std::string> m_registers_modified;
+
+  std::unique_ptr<wxTimer> m_registers_timer;
+
   reflection m_reflect;
 };
 }; // namespace wex
@@ -70,6 +70,9 @@ public:
   /// Returns the find string.
   const std::string get_find_string() const;
 
+  /// Returns the regular expression (valid if is_regex).
+  const boost::regex& get_regex() const { return m_regex; }
+
   /// Returns the replace string.
   const std::string get_replace_string() const;
 
@@ -81,6 +81,9 @@ private:
 
   std::set<std::string> m_inserts;
 
+  // Buffer for the completions, reused on each keystroke.
+  mutable std::string m_completions;
+
   scope* m_scope;
   stc*   m_stc;
 };
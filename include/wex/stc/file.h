@@ -9,6 +9,9 @@
 
 #include <wex/core/file.h>
 
+#include <memory>
+#include <string>
+
 namespace wex
 {
 class ex_stream;
@@ -35,8 +38,8 @@ public:
     /// the path to be assigned
     const wex::path& p = wex::path());
 
-  /// Destructor.
-  ~stc_file() = default;
+  /// Destructor, cancels loading the file if still busy.
+  ~stc_file();
 
   /// The ex stream (used if in ex mode), might be nullptr.
   class ex_stream*       ex_stream();
@@ -50,7 +53,17 @@ private:
   void do_file_new() override;
   void do_file_save(bool save_as = false) override;
 
-  stc*           m_stc;
-  std::streampos m_previous_size{0};
+  struct load_state;
+
+  bool follow();
+  bool load_async(size_t size);
+  void load_cancel();
+  void load_finish(void* loader, bool ok, bool readonly);
+
+  stc*                        m_stc;
+  std::shared_ptr<load_state> m_load;
+  std::streampos              m_previous_size{0};
+  ino_t                       m_follow_inode{0};
+  std::string                 m_follow_buffer;
 };
 }; // namespace wex
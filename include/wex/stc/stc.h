@@ -265,7 +265,7 @@ public:
   void show_ascii_value(bool byte_only = false) override;
   void show_line_numbers(bool show) override;
   void show_whitespace(bool show) override;
-  void sync(bool start = true) override { m_function_repeat.activate(start); }
+  void sync(bool start = true) override;
 
   void use_modification_markers(bool use) override;
 
@@ -304,11 +304,12 @@ private:
   void on_styled_text(wxStyledTextEvent& event);
   void show_properties();
   void sort_action(const wxCommandEvent& event);
+  void sync_changed();
 
   const marker              m_marker_change{marker(1)};
   const std::vector<marker> m_marker_diffs{marker(3), marker(4), marker(5)};
 
-  bool m_skip{false};
+  bool m_skip{false}, m_statusbar_pending{false};
 
   frame* m_frame;
 
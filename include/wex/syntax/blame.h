@@ -7,7 +7,12 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <optional>
 #include <pugixml.hpp>
+#include <string_view>
+#include <unordered_map>
 
 namespace wex
 {
@@ -23,6 +28,8 @@ class stc;
 /// using the xml_node constructor (see wex-menus.xml),
 /// the kind of info returned after parse is configurable using
 /// blame_get_author, blame_get_id, blame_get_date.
+/// The blame output can be parsed line by line using parse, or as a
+/// stream of chunks using stream_begin, stream and stream_end.
 // clang-format off
 /// \dot
 /// digraph mode {
@@ -88,6 +95,9 @@ public:
     OTHER          ///< more than a year
   };
 
+  /// Callback invoked for each line parsed from a stream.
+  typedef std::function<void(blame&)> parsed_t;
+
   // Static interface.
 
   /// Returns a renamed path present in the stc margin,
@@ -141,19 +151,55 @@ public:
   /// Style for blame margin based on commit date.
   margin_style_t style() const { return m_style; };
 
+  /// Parses next chunk of a stream of blame output, the chunk might
+  /// end within a line, that line is parsed when completed by a next chunk.
+  /// Invokes f for each line parsed.
+  /// Returns number of lines parsed.
+  size_t stream(std::string_view chunk, const parsed_t& f);
+
+  /// Begins a stream of blame output for the path, the config
+  /// is read once, and the style is decoded once per commit,
+  /// until stream_end.
+  void stream_begin(const path& p);
+
+  /// Ends the stream, parsing a last line without newline.
+  /// Returns number of lines parsed.
+  size_t stream_end(const parsed_t& f);
+
   /// Returns vcs name for which this blaming is done.
   const std::string& vcs_name() const { return m_name; };
 
 private:
-  bool is_renamed_path() const;
+  struct settings
+  {
+    bool id, author, date;
+    int  author_size;
+  };
+
+  static settings get_settings();
+
+  std::string build(
+    const std::string& field,
+    bool               use,
+    bool               first = false,
+    int                size  = -1) const;
+  bool        is_renamed_path() const;
   bool parse_compact(const std::string& line, const regex& r);
   bool parse_full(const std::string& line, const regex& r);
 
-  margin_style_t
-  get_style(const std::string& hash, const std::string& text) const;
+  margin_style_t get_style(const std::string& hash, const std::string& text);
+  size_t         stream_line(std::string_view line, const parsed_t& f);
 
   std::string m_blame_format, m_caption, m_date_format, m_info, m_line_text,
-    m_name, m_path;
+    m_name, m_path, m_stream_rest;
+
+  // The regex is compiled once, a copy gets its own regex
+  // when it parses, as the regex holds the matches.
+  std::shared_ptr<regex> m_regex;
+
+  std::optional<settings> m_settings;
+
+  std::unordered_map<std::string, margin_style_t> m_styles;
 
   wex::path m_path_original;
 
@@ -10,6 +10,7 @@
 #include <wex/syntax/property.h>
 #include <wex/syntax/style.h>
 
+#include <chrono>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -63,6 +64,8 @@ public:
     bool fill_out = false) const;
 
   /// Applies this lexer to stc component (and colours the component).
+  /// A large document is only coloured up to the visible part,
+  /// the rest is coloured using colourise.
   bool apply() const;
 
   /// Returns specified config attrib.
@@ -73,6 +76,16 @@ public:
   /// The is ok member is set to false.
   void clear();
 
+  /// Colours next part of the document, within the time budget,
+  /// if apply did not colour the entire document.
+  /// Returns true if there is more to colour.
+  bool colourise(
+    std::chrono::milliseconds budget = std::chrono::milliseconds(10)) const;
+
+  /// Returns the part of the document that is coloured,
+  /// from 0 (nothing) to 1 (entire document).
+  double colourised() const;
+
   /// Returns a string that completes specified comment,
   /// by adding spaces and a comment end at the end.
   /// If the comment end string is empty, it returns empty string.
@@ -180,6 +193,7 @@ private:
   explicit lexer(const pugi::xml_node* node, syntax::stc* s);
 
   void              auto_match(const std::string& lexer);
+  void              colourise_begin() const;
   const std::string formatted_text(
     const std::string& lines,
     const std::string& header,
@@ -211,6 +225,10 @@ private:
 
   bool m_is_ok{false}, m_previewable{false};
 
+  // Colourise state, set by apply.
+  mutable bool                                  m_colourise_pending{false};
+  mutable std::chrono::steady_clock::time_point m_colourise_start;
+
   syntax::stc* m_stc{nullptr};
 };
 }; // namespace wex
@@ -11,12 +11,14 @@
 
 #include <array>
 #include <map>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
 #include <wex/core/path.h>
 #include <wex/core/reflection.h>
+#include <wex/syntax/blame.h>
 #include <wex/syntax/indicator.h>
 #include <wex/syntax/lexer.h>
 #include <wex/syntax/marker.h>
@@ -25,7 +27,7 @@ class wxWindow;
 
 namespace wex
 {
-class blame;
+class lexers_index;
 
 namespace factory
 {
@@ -56,6 +58,9 @@ public:
   /// (both the parameter and returned value may be nullptr).
   static lexers* set(lexers* lexers);
 
+  /// Destructor.
+  ~lexers();
+
   // Other methods
 
   /// Applies containers (except global styles) to specified component.
@@ -85,6 +90,19 @@ public:
     /// blame info to use
     const blame* info) const;
 
+  /// Applies margin text style to stc line, and sets margin text
+  /// if not empty. This allows setting the margin for many lines
+  /// after parsing.
+  void apply_margin_text_style(
+    /// stc component
+    factory::stc* stc,
+    /// the line
+    int line,
+    /// the style
+    blame::margin_style_t style,
+    /// the margin text
+    const std::string& text) const;
+
   /// Clears the theme.
   void clear_theme();
 
@@ -208,6 +226,8 @@ private:
 
   std::vector<std::pair<std::string, std::string>> m_texts;
 
+  std::unique_ptr<lexers_index> m_index;
+
   const std::unordered_map<
     std::string,
     std::function<void(factory::stc* stc, const std::string& colour)>>
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      listview-store.h
+// Purpose:   Declaration of class wex::listview_store
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wex/factory/listview.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace wex
+{
+/// Offers the items of a virtual listview, stored per column.
+/// The texts are kept in one arena, a cell is only an offset and size,
+/// and a text equal to the one in the row above is not stored again.
+/// INT columns are kept as numbers, as long as each text is the
+/// number as string.
+class listview_store
+{
+public:
+  /// Appends a column.
+  void append_column(column::type_t type);
+
+  /// Returns number of columns.
+  size_t columns() const { return m_columns.size(); }
+
+  /// Clears all rows, keeps the columns.
+  void clear();
+
+  /// Erases a row.
+  void erase(size_t row);
+
+  /// Returns the text of a cell, empty if not present.
+  const std::string get(size_t row, size_t col) const;
+
+  /// Returns the number of a cell in an INT column, if present.
+  std::optional<long long> get_number(size_t row, size_t col) const;
+
+  /// Inserts a row, missing columns are empty.
+  /// If index is -1, appends the row, otherwise inserts before index.
+  /// Returns false if the row has more columns than present.
+  bool insert(const std::vector<std::string>& row, long index = -1);
+
+  /// Returns true if the text of a cell equals text, without copying it.
+  bool is_equal(size_t row, size_t col, const std::string& text) const;
+
+  /// Reorders the rows, row i becomes the row order[i].
+  void reorder(const std::vector<long>& order);
+
+  /// Sets the text of a cell.
+  void set(size_t row, size_t col, const std::string& text);
+
+  /// Returns number of rows.
+  size_t size() const { return m_size; }
+
+private:
+  struct cell
+  {
+    uint64_t offset;
+    uint32_t size;
+  };
+
+  struct column_t
+  {
+    column::type_t type;
+
+    /// Whether the column is kept as numbers.
+    bool is_numbers;
+
+    /// Cells, for a column not kept as numbers.
+    std::vector<cell> cells;
+
+    /// Numbers, for a column kept as numbers.
+    std::vector<long long> numbers;
+  };
+
+  const cell add(const column_t& c, size_t row, const std::string& text);
+  void       to_cells(column_t& c);
+
+  std::string           m_arena;
+  std::vector<column_t> m_columns;
+  size_t                m_size{0};
+};
+}; // namespace wex
@@ -7,13 +7,16 @@
 
 #pragma once
 
+#include <wex/common/match-ring.h>
 #include <wex/common/path-match.h>
 #include <wex/core/types.h>
 #include <wex/data/listview.h>
 #include <wex/factory/listview.h>
+#include <wex/ui/listview-store.h>
 
 #include <wx/artprov.h> // for wxArtID
 
+#include <memory>
 #include <unordered_map>
 
 namespace wex
@@ -37,6 +40,9 @@ public:
   /// Default constructor.
   explicit listview(const data::listview& data = data::listview());
 
+  /// Destructor.
+  ~listview() override;
+
   // Virtual interface
 
   /// Inserts new item with column values from text.
@@ -149,18 +155,30 @@ private:
   /// Returns the index of the bitmap in the image list used by this list
   /// view. If the artid is not yet on the image lists, it is added to the
   /// image list. Use only if you setup for IMAGE_ART.
-  unsigned int get_art_id(const wxArtID& artid);
-  column       get_column(const std::string& name) const;
-  void         item_activated(long item_number);
-  bool         on_command(const wxCommandEvent& event);
-
+  unsigned int      get_art_id(const wxArtID& artid);
+  column            get_column(const std::string& name) const;
+  void              insert_match(const path_match& m);
+  void              item_activated(long item_number);
+  const std::string item_text(long item_number, int col) const;
+  bool              on_command(const wxCommandEvent& event);
+
+  void process_changed(const path& p);
   void process_idle(wxIdleEvent& event);
   void process_list(const wxListEvent& event, wxEventType type);
   void process_match(const wxCommandEvent& event);
+  void process_matches();
   void process_mouse(const wxMouseEvent& event);
 
   bool report_view(const std::string& text);
 
+  void sync_item(long item_number);
+  void sync_sort();
+  void watch_items();
+
+  // For an owner data list, the items are taken from the store.
+  int      OnGetItemImage(long item) const override { return -1; }
+  wxString OnGetItemText(long item, long column) const override;
+
   char m_field_separator = '\t';
 
   data::listview m_data;
@@ -168,11 +186,28 @@ private:
   bool m_item_updated = false;
   long m_item_number  = 0;
 
+  long   m_watch_count = -1;
+  size_t m_watch_id    = 0;
+
+  std::vector<path> m_watch_paths;
+
   int m_col_event_id     = -1;
   int m_sorted_column_no = -1, m_to_be_sorted_column_no = -1;
 
+  // Column numbers used by insert_match, set by append_columns.
+  struct match_columns
+  {
+    int file_name{-1}, in_folder{-1}, type{-1}, modified{-1}, size{-1},
+      line_no{-1}, line{-1}, match{-1};
+  };
+
   std::unordered_map<wxArtID, unsigned int> m_art_ids;
   std::vector<column>                       m_columns;
+  match_columns                             m_match_columns;
+
+  listview_store m_store;
+
+  std::shared_ptr<match_ring> m_matches;
 
   frame* m_frame;
 
@@ -24,6 +24,7 @@
 #include <wex/ui/item-vector.h>
 #include <wex/ui/item.h>
 #include <wex/ui/listitem.h>
+#include <wex/ui/listview-store.h>
 #include <wex/ui/listview.h>
 #include <wex/ui/menu-commands.h>
 #include <wex/ui/menu-item.h>
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      blame-cache.h
+// Purpose:   Declaration of class wex::blame_cache
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wex/core/path.h>
+
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace wex
+{
+/// Offers a blame cache for git, to get blame info for a line
+/// without running git for each line.
+/// A file is blamed once on a thread using git blame --porcelain,
+/// and blamed again after the file or the git HEAD has changed.
+class blame_cache
+{
+public:
+  /// The blame info of a commit.
+  struct commit
+  {
+    std::string id;      ///< commit hash
+    std::string author;  ///< author name
+    std::string summary; ///< first line of commit message
+    time_t      time{0}; ///< author time
+    int         tz{0};   ///< author timezone offset in seconds
+  };
+
+  /// The blame of a file, the commit index for each line.
+  struct blamed
+  {
+    std::vector<commit>   commits;
+    std::vector<uint32_t> lines;
+  };
+
+  /// The callback invoked after a file has been blamed.
+  /// It is invoked from the blame thread.
+  typedef std::function<void(const path&)> notify_t;
+
+  /// Returns the text using a git log format,
+  /// supporting %H, %h, %an, %ad (short date) and %s.
+  static std::string format(const commit& c, const std::string& fmt);
+
+  /// Parses git blame --porcelain output.
+  static blamed parse(const std::string& text);
+
+  /// Constructor.
+  explicit blame_cache(notify_t notify = nullptr);
+
+  /// Destructor, waits for running blames, their results are discarded.
+  ~blame_cache();
+
+  /// Returns the commit for the line (starting with line 0),
+  /// or nullopt if the file is not (yet) blamed, or the line not committed.
+  /// If the file is not yet blamed, or changed, it is blamed
+  /// on a thread, and notify is invoked when ready.
+  /// Whether the file or the git HEAD changed is checked at most
+  /// once a second.
+  std::optional<commit> find(const path& p, int line);
+
+private:
+  struct stamp
+  {
+    std::filesystem::file_time_type time;
+    std::string                     head;
+
+    bool operator==(const stamp&) const = default;
+  };
+
+  struct state;
+
+  static stamp get_stamp(const path& p, const path& toplevel);
+
+  std::shared_ptr<state> m_state;
+};
+}; // namespace wex
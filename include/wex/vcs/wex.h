@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <wex/vcs/blame-cache.h>
 #include <wex/vcs/debug.h>
 #include <wex/vcs/process.h>
 #include <wex/vcs/unified-diff.h>
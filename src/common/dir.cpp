@@ -14,6 +14,9 @@
 #include <wex/core/reflection.h>
 #include <wx/translation.h>
 
+#include "find-pool.h"
+
+#include <memory>
 #include <thread>
 #include <utility>
 
@@ -161,7 +164,8 @@ bool wex::dir::find_files(const tool& tool)
 
 void wex::dir::find_files_end() const
 {
-  log::status(m_tool.info(&m_statistics.get_elements()));
+  const auto& elements(m_statistics.get_elements());
+  log::status(m_tool.info(&elements));
 
   if (m_eh != nullptr)
   {
@@ -172,7 +176,7 @@ void wex::dir::find_files_end() const
 
 int wex::dir::matches() const
 {
-  return m_statistics.get_elements().get(_("Files"));
+  return m_statistics.get(stream_statistics::ACTIONS);
 }
 
 bool wex::dir::on_dir(const path& p) const
@@ -181,7 +185,7 @@ bool wex::dir::on_dir(const path& p) const
   {
     if (!m_tool.is_find_type() && m_data.type().test(data::dir::DIRS))
     {
-      m_statistics.get_elements().inc(_("Folders"));
+      m_statistics.inc(stream_statistics::FOLDERS);
       process_match(p, m_eh);
     }
   }
@@ -193,7 +197,11 @@ bool wex::dir::on_file(const path& p) const
 {
   if (m_eh != nullptr)
   {
-    if (m_tool.is_find_type())
+    if (m_tool.is_find_type() && m_pool != nullptr)
+    {
+      m_pool->add(p);
+    }
+    else if (m_tool.is_find_type())
     {
       stream s(m_data.find_replace_data(), p, m_tool, m_eh);
 
@@ -227,6 +235,16 @@ int wex::dir::run() const
 
   log::trace("thread") << id << "started" << reflect;
 
+  // The pool is destroyed after traversal, and waits for
+  // all added files.
+  std::unique_ptr<find_pool> pool;
+
+  if (m_eh != nullptr && m_tool.is_find_type() && m_data.threads() != 1)
+  {
+    pool   = std::make_unique<find_pool>(m_data, m_tool, m_eh, m_statistics);
+    m_pool = pool.get();
+  }
+
   try
   {
     if (m_data.type().test(data::dir::RECURSIVE))
@@ -249,6 +267,8 @@ int wex::dir::run() const
           if (!traverse(*i))
           {
             log::trace("iterating aborted");
+            pool.reset();
+            m_pool = nullptr;
             return matches();
           }
         }
@@ -273,6 +293,9 @@ int wex::dir::run() const
     log(e) << "exception";
   }
 
+  pool.reset();
+  m_pool = nullptr;
+
   log::trace("thread") << id << "ended matches:" << matches() << reflect.log();
 
   end();
@@ -291,10 +314,7 @@ bool wex::dir::traverse(const fs::directory_entry& e) const
        (m_data.vcs() != nullptr &&
         !m_data.vcs()->is_file_excluded(e.path()))) &&
       m_data.type().test(data::dir::FILES) && allow_hidden(e.path(), m_data) &&
-      matches_one_of(
-        e.path().filename().string(),
-        m_data.file_spec(),
-        m_data.is_regex()))
+      m_data.file_matcher().matches(e.path().filename().string()))
     {
       if (on_file(e.path()))
       {
@@ -303,10 +323,8 @@ bool wex::dir::traverse(const fs::directory_entry& e) const
     }
   }
   else if (
-    m_data.dir_spec().empty() || matches_one_of(
-                                   e.path().filename().string(),
-                                   m_data.dir_spec(),
-                                   m_data.is_regex()))
+    m_data.dir_spec().empty() ||
+    m_data.dir_matcher().matches(e.path().filename().string()))
   {
     on_dir(e.path());
 
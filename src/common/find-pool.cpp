@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      find-pool.cpp
+// Purpose:   Implementation of class wex::find_pool
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/common/stream.h>
+#include <wex/common/util.h>
+#include <wex/core/interruptible.h>
+#include <wex/core/log.h>
+
+#include "find-pool.h"
+
+#include <algorithm>
+#include <optional>
+
+wex::find_pool::find_pool(
+  const data::dir&   data,
+  const tool&        tool,
+  wxEvtHandler*      eh,
+  stream_statistics& statistics)
+  : m_data(data)
+  , m_tool(tool)
+  , m_eh(eh)
+  , m_statistics(statistics)
+{
+  const size_t threads(
+    data.threads() > 0 ? data.threads() :
+                         std::max(1U, std::thread::hardware_concurrency()));
+
+  for (size_t i = 0; i < threads; i++)
+  {
+    m_queues.emplace_back(std::make_unique<queue>());
+  }
+
+  m_statistics_threads.resize(threads);
+
+  for (size_t i = 0; i < threads; i++)
+  {
+    m_threads.emplace_back(
+      [this, i]
+      {
+        work(i);
+      });
+  }
+
+  log::trace("find pool threads") << threads;
+}
+
+wex::find_pool::~find_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_done = true;
+  }
+
+  m_cv.notify_all();
+
+  for (auto& t : m_threads)
+  {
+    t.join();
+  }
+
+  for (const auto& s : m_statistics_threads)
+  {
+    m_statistics += s;
+  }
+}
+
+void wex::find_pool::add(const path& p)
+{
+  // Count the job before it can be taken, so the count does not wrap.
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queued++;
+  }
+
+  {
+    auto& q(*m_queues[m_added % m_queues.size()]);
+
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.jobs.push_back({m_added, p});
+  }
+
+  m_added++;
+
+  m_cv.notify_one();
+}
+
+void wex::find_pool::deliver(size_t no, std::vector<path_match>& matches)
+{
+  std::lock_guard<std::mutex> lock(m_deliver_mutex);
+
+  if (no != m_deliver_no)
+  {
+    // Keep the matches until all matches of previous files are delivered.
+    m_delivered.emplace(no, std::move(matches));
+    return;
+  }
+
+  for (const auto& m : matches)
+  {
+    process_match(m, m_eh);
+  }
+
+  m_deliver_no++;
+
+  for (auto it = m_delivered.begin();
+       it != m_delivered.end() && it->first == m_deliver_no;
+       it = m_delivered.erase(it))
+  {
+    for (const auto& m : it->second)
+    {
+      process_match(m, m_eh);
+    }
+
+    m_deliver_no++;
+  }
+}
+
+bool wex::find_pool::take(size_t worker, std::optional<job>& j)
+{
+  for (size_t i = 0; i < m_queues.size(); i++)
+  {
+    auto& q(*m_queues[(worker + i) % m_queues.size()]);
+
+    {
+      std::lock_guard<std::mutex> lock(q.mutex);
+
+      if (q.jobs.empty())
+      {
+        continue;
+      }
+
+      // Take from the front of the own queue,
+      // and steal from the back of other queues.
+      if (i == 0)
+      {
+        j.emplace(std::move(q.jobs.front()));
+        q.jobs.pop_front();
+      }
+      else
+      {
+        j.emplace(std::move(q.jobs.back()));
+        q.jobs.pop_back();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queued--;
+
+    return true;
+  }
+
+  return false;
+}
+
+void wex::find_pool::work(size_t worker)
+{
+  while (true)
+  {
+    std::optional<job> j;
+
+    if (!take(worker, j))
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      m_cv.wait(
+        lock,
+        [this]
+        {
+          return m_queued > 0 || m_done;
+        });
+
+      if (m_queued == 0 && m_done)
+      {
+        return;
+      }
+
+      continue;
+    }
+
+    std::vector<path_match> matches;
+
+    // If interrupted, remaining files are skipped.
+    if (interruptible::is_running())
+    {
+      stream s(m_data.find_replace_data(), j->p, m_tool, m_eh);
+
+      s.use_interruptible();
+      s.use_prompt(false);
+
+      if (m_data.is_ordered())
+      {
+        s.use_match(
+          [&matches](const path_match& m)
+          {
+            matches.emplace_back(m);
+          });
+      }
+
+      if (!s.run_tool())
+      {
+        interruptible::end();
+      }
+
+      m_statistics_threads[worker] += s.get_statistics();
+    }
+
+    if (m_data.is_ordered())
+    {
+      deliver(j->no, matches);
+    }
+  }
+}
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      find-pool.h
+// Purpose:   Declaration of class wex::find_pool
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wex/common/path-match.h>
+#include <wex/common/stream-statistics.h>
+#include <wex/common/tool.h>
+#include <wex/data/dir.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+class wxEvtHandler;
+
+namespace wex
+{
+/// Offers a pool of threads that run a find tool on files,
+/// while the directory traversal continues adding files.
+/// Each thread has its own queue, and steals files from the other
+/// queues if its own queue is empty.
+/// Matches are delivered to the event handler in the order
+/// files were added, or as soon as found (see data::dir::is_ordered).
+class find_pool
+{
+public:
+  /// Constructor, starts the threads.
+  find_pool(
+    const data::dir&   data,
+    const tool&        tool,
+    wxEvtHandler*      eh,
+    stream_statistics& statistics);
+
+  /// Destructor, waits for all files to be processed,
+  /// and adds the statistics of all threads.
+  ~find_pool();
+
+  /// Adds a file.
+  void add(const path& p);
+
+  /// Returns number of threads.
+  size_t threads() const { return m_threads.size(); }
+
+private:
+  struct job
+  {
+    size_t no;
+    path   p;
+  };
+
+  struct queue
+  {
+    std::mutex      mutex;
+    std::deque<job> jobs;
+  };
+
+  void deliver(size_t no, std::vector<path_match>& matches);
+  bool take(size_t worker, std::optional<job>& j);
+  void work(size_t worker);
+
+  const data::dir    m_data;
+  const tool         m_tool;
+  wxEvtHandler*      m_eh;
+  stream_statistics& m_statistics;
+
+  std::vector<std::unique_ptr<queue>> m_queues;
+  std::vector<stream_statistics>      m_statistics_threads;
+  std::vector<std::thread>            m_threads;
+
+  std::mutex              m_mutex;
+  std::condition_variable m_cv;
+  std::atomic<size_t>     m_queued{0};
+  bool                    m_done{false};
+  size_t                  m_added{0};
+
+  std::mutex                                m_deliver_mutex;
+  std::map<size_t, std::vector<path_match>> m_delivered;
+  size_t                                    m_deliver_no{0};
+};
+}; // namespace wex
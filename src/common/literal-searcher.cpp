@@ -0,0 +1,211 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      literal-searcher.cpp
+// Purpose:   Implementation of class wex::literal_searcher
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <wex/common/literal-searcher.h>
+
+namespace wex
+{
+// Returns table to fold ASCII upper case chars to lower case.
+constexpr std::array<char, 256> fold_table()
+{
+  std::array<char, 256> table{};
+
+  for (int i = 0; i < 256; i++)
+  {
+    table[i] = static_cast<char>(i >= 'A' && i <= 'Z' ? i + ('a' - 'A') : i);
+  }
+
+  return table;
+}
+
+constexpr auto fold = fold_table();
+
+char fold_char(char c)
+{
+  return fold[static_cast<unsigned char>(c)];
+}
+
+// Returns the mask that folds char c when or-ed.
+char fold_mask(char c, bool match_case)
+{
+  return !match_case && c >= 'a' && c <= 'z' ? 0x20 : 0;
+}
+} // namespace wex
+
+wex::literal_searcher::literal_searcher(
+  const std::string& text,
+  bool               match_case,
+  bool               match_word)
+  : m_text(text)
+  , m_match_case(match_case)
+  , m_match_word(match_word)
+{
+  if (!m_match_case)
+  {
+    std::ranges::transform(m_text, m_text.begin(), fold_char);
+  }
+
+  if (!m_text.empty())
+  {
+    m_first_mask = fold_mask(m_text.front(), m_match_case);
+    m_last_mask  = fold_mask(m_text.back(), m_match_case);
+  }
+}
+
+bool wex::literal_searcher::equal(const char* s) const
+{
+  if (m_match_case)
+  {
+    return std::memcmp(s, m_text.data(), m_text.size()) == 0;
+  }
+
+  for (size_t i = 0; i < m_text.size(); i++)
+  {
+    if (fold_char(s[i]) != m_text[i])
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+size_t wex::literal_searcher::find(std::string_view text, size_t start) const
+{
+  for (size_t pos = start;
+       (pos = find_candidate(text, pos)) != std::string::npos;
+       pos++)
+  {
+    if (!m_match_word || is_word(text, pos))
+    {
+      return pos;
+    }
+  }
+
+  return std::string::npos;
+}
+
+size_t wex::literal_searcher::find_all(std::string_view text, const match_t& f)
+  const
+{
+  size_t count = 0;
+
+  for (size_t pos = 0; (pos = find(text, pos)) != std::string::npos;
+       pos += m_text.size())
+  {
+    count++;
+
+    if (!f(pos))
+    {
+      break;
+    }
+  }
+
+  return count;
+}
+
+size_t
+wex::literal_searcher::find_candidate(std::string_view text, size_t start) const
+{
+  const size_t n = m_text.size();
+
+  if (n == 0 || text.size() < n || start > text.size() - n)
+  {
+    return std::string::npos;
+  }
+
+  // The last pos where a match might start.
+  const size_t last = text.size() - n;
+  const char*  s    = text.data();
+  size_t       i    = start;
+
+#if defined(__AVX2__)
+  const auto first      = _mm256_set1_epi8(m_text.front());
+  const auto last_char  = _mm256_set1_epi8(m_text.back());
+  const auto first_mask = _mm256_set1_epi8(m_first_mask);
+  const auto last_mask  = _mm256_set1_epi8(m_last_mask);
+
+  for (; i + 32 <= last + 1; i += 32)
+  {
+    const auto block_first =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+    const auto block_last =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + n - 1));
+
+    auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(
+      _mm256_cmpeq_epi8(_mm256_or_si256(block_first, first_mask), first),
+      _mm256_cmpeq_epi8(_mm256_or_si256(block_last, last_mask), last_char))));
+
+    for (; mask != 0; mask &= mask - 1)
+    {
+      if (const auto pos = i + std::countr_zero(mask); equal(s + pos))
+      {
+        return pos;
+      }
+    }
+  }
+#elif defined(__SSE2__)
+  const auto first      = _mm_set1_epi8(m_text.front());
+  const auto last_char  = _mm_set1_epi8(m_text.back());
+  const auto first_mask = _mm_set1_epi8(m_first_mask);
+  const auto last_mask  = _mm_set1_epi8(m_last_mask);
+
+  for (; i + 16 <= last + 1; i += 16)
+  {
+    const auto block_first =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    const auto block_last =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + n - 1));
+
+    auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(
+      _mm_cmpeq_epi8(_mm_or_si128(block_first, first_mask), first),
+      _mm_cmpeq_epi8(_mm_or_si128(block_last, last_mask), last_char))));
+
+    for (; mask != 0; mask &= mask - 1)
+    {
+      if (const auto pos = i + std::countr_zero(mask); equal(s + pos))
+      {
+        return pos;
+      }
+    }
+  }
+#endif
+
+  for (; i <= last; i++)
+  {
+    if (
+      (s[i] | m_first_mask) == m_text.front() &&
+      (s[i + n - 1] | m_last_mask) == m_text.back() && equal(s + i))
+    {
+      return i;
+    }
+  }
+
+  return std::string::npos;
+}
+
+bool wex::literal_searcher::is_word(std::string_view text, size_t pos) const
+{
+  const auto is_word_character = [](char c)
+  {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+  };
+
+  return (pos == 0 || !is_word_character(text[pos - 1])) &&
+         (pos + m_text.size() >= text.size() ||
+          !is_word_character(text[pos + m_text.size()]));
+}
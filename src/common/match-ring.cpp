@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      match-ring.cpp
+// Purpose:   Implementation of class wex::match_ring
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/common/match-ring.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <unordered_map>
+
+namespace wex
+{
+std::mutex registry_mutex;
+
+std::unordered_map<wxEvtHandler*, std::shared_ptr<match_ring>> registry;
+} // namespace wex
+
+std::shared_ptr<wex::match_ring> wex::match_ring::get(wxEvtHandler* eh)
+{
+  std::lock_guard<std::mutex> lock(registry_mutex);
+
+  const auto& it = registry.find(eh);
+  return it != registry.end() ? it->second : nullptr;
+}
+
+void wex::match_ring::set(wxEvtHandler* eh, std::shared_ptr<match_ring> ring)
+{
+  std::shared_ptr<match_ring> previous;
+
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+
+    if (const auto& it = registry.find(eh); it != registry.end())
+    {
+      previous = it->second;
+      registry.erase(it);
+    }
+
+    if (ring != nullptr)
+    {
+      registry.emplace(eh, ring);
+    }
+  }
+
+  if (previous != nullptr && previous != ring)
+  {
+    previous->close();
+  }
+}
+
+wex::match_ring::match_ring(size_t capacity, notify_t notify)
+  : m_notify(std::move(notify))
+  , m_slots(std::bit_ceil(std::max<size_t>(capacity, 2)))
+{
+}
+
+void wex::match_ring::close()
+{
+  {
+    // Taking the lock, so no producer is notifying after close.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_closed = true;
+  }
+
+  m_space.notify_all();
+}
+
+bool wex::match_ring::push(const path_match& m)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  // The consumer does not lock when taking, so a wakeup might be missed,
+  // the wait is therefore limited.
+  while (!m_closed && size() == capacity())
+  {
+    m_space.wait_for(lock, std::chrono::milliseconds(10));
+  }
+
+  if (m_closed)
+  {
+    return false;
+  }
+
+  const auto tail = m_tail.load(std::memory_order_relaxed);
+
+  m_slots[tail & (capacity() - 1)].emplace(m);
+  m_tail.store(tail + 1, std::memory_order_release);
+
+  if (!m_notified.exchange(true) && m_notify != nullptr)
+  {
+    m_notify();
+  }
+
+  return true;
+}
+
+size_t wex::match_ring::take(const take_t& f, size_t max)
+{
+  // Reset first, so a match pushed while taking notifies again.
+  m_notified = false;
+
+  auto       head = m_head.load(std::memory_order_relaxed);
+  const auto tail = m_tail.load(std::memory_order_acquire);
+  size_t     taken = 0;
+
+  for (; head != tail && taken < max; head++, taken++)
+  {
+    auto& slot(m_slots[head & (capacity() - 1)]);
+
+    f(*slot);
+    slot.reset();
+
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  if (taken > 0)
+  {
+    m_space.notify_one();
+  }
+
+  return taken;
+}
@@ -5,20 +5,42 @@
 // Copyright: (c) 2008-2024 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <boost/algorithm/string.hpp>
 #include <wex/common/stream.h>
 #include <wex/common/util.h>
 #include <wex/core/config.h>
+#include <wex/core/interruptible.h>
 #include <wex/core/log.h>
 #include <wex/factory/beautify.h>
 #include <wex/factory/frd.h>
 #include <wx/msgdlg.h>
 
 #include <algorithm>
-#include <cctype>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <functional>
 
+namespace wex
+{
+// Moves line_start to the start of the line containing pos,
+// and returns the number of lines skipped.
+size_t skip_lines(std::string_view text, size_t& line_start, size_t pos)
+{
+  size_t lines = 0;
+
+  for (const char* nl;
+       (nl = static_cast<const char*>(
+          std::memchr(text.data() + line_start, '\n', pos - line_start))) !=
+       nullptr;)
+  {
+    lines++;
+    line_start = nl - text.data() + 1;
+  }
+
+  return lines;
+}
+} // namespace wex
+
 wex::stream::stream(
   factory::find_replace_data* frd,
   const wex::path&            filename,
@@ -40,84 +62,67 @@ bool wex::stream::process(std::string& text, size_t line_no)
 
   if (m_frd->is_regex())
   {
-    pos   = m_frd->regex_search(text);
-    match = (pos >= 0);
-
-    if (match && (m_tool.id() == ID_TOOL_REPLACE))
+    if (m_substitute)
     {
-      count = m_frd->regex_replace(text);
+      // finds pos and count, and replaces, in one pass
+      count = m_substitute->replace(text, &pos);
+      match = (count > 0);
+
       if (!m_modified)
       {
-        m_modified = (count > 0);
+        m_modified = match;
       }
     }
+    else
+    {
+      pos   = m_frd->regex_search(text);
+      match = (pos >= 0);
+    }
   }
   else
   {
-    if (m_tool.id() == ID_TOOL_REPORT_FIND)
-    {
-      auto text_find(text);
-
-      if (!m_frd->match_case())
-      {
-        boost::algorithm::to_upper(text_find);
-      }
+    count = replace_all(text, &pos);
 
-      if (const auto it = std::search(
-            text_find.begin(),
-            text_find.end(),
-            std::boyer_moore_searcher(
-              m_find_string.begin(),
-              m_find_string.end()));
-          it != text_find.end())
-      {
-        match = true;
-        pos   = it - text_find.begin();
-
-        if (
-          m_frd->match_word() &&
-          ((it != text_find.begin() && is_word_character(*std::prev(it))) ||
-           is_word_character(*std::next(it, m_find_string.length()))))
-        {
-          match = false;
-        }
-      }
-    }
-    else
+    match = (count > 0);
+    if (!m_modified)
     {
-      count = replace_all(text, &pos);
-
-      match = (count > 0);
-      if (!m_modified)
-      {
-        m_modified = match;
-      }
+      m_modified = match;
     }
   }
 
-  if (match)
+  return !match || process_match(text, line_no, pos, count);
+}
+
+bool wex::stream::process_match(
+  const std::string& text,
+  size_t             line_no,
+  int                pos,
+  int                count)
+{
+  if (m_tool.is_find_type() && m_match != nullptr)
   {
-    if (m_tool.is_find_type() && m_eh != nullptr)
-    {
-      process_match(path_match(path(), m_tool, text, line_no, pos), m_eh);
-    }
+    m_match(path_match(path(), m_tool, text, line_no, pos));
+  }
+  else if (m_tool.is_find_type() && m_eh != nullptr)
+  {
+    wex::process_match(path_match(path(), m_tool, text, line_no, pos), m_eh);
+  }
 
-    const auto ac = m_stats.inc_actions_completed(count);
+  const auto ac = m_stats.inc_actions_completed(count);
 
-    if (!m_asked && m_threshold != -1 && (ac - m_prev > m_threshold))
+  if (m_prompt && !m_asked && m_threshold != -1 && (ac - m_prev > m_threshold))
+  {
+    if (
+      wxMessageBox(
+        "More than " + std::to_string(m_threshold) +
+          " matches in: " + m_path.string() + "?",
+        _("Continue"),
+        wxYES_NO | wxICON_QUESTION) == wxNO)
     {
-      if (
-        wxMessageBox(
-          "More than " + std::to_string(m_threshold) +
-            " matches in: " + m_path.string() + "?",
-          _("Continue"),
-          wxYES_NO | wxICON_QUESTION) == wxNO)
-      {
-        return false;
-      }
-
-      m_asked = true;
+      return false;
     }
+
+    m_asked = true;
   }
 
   return true;
@@ -134,17 +139,19 @@ bool wex::stream::process_begin()
     return false;
   }
 
-  m_prev  = m_stats.get(_("Actions Completed").ToStdString());
+  m_prev  = m_stats.get(stream_statistics::ACTIONS_COMPLETED);
   m_write = (m_tool.id() == ID_TOOL_REPLACE);
 
-  if (!m_frd->is_regex())
+  if (!m_frd->is_regex() && m_tool.id() == ID_TOOL_REPORT_FIND)
   {
-    m_find_string = m_frd->get_find_string();
-
-    if (!m_frd->match_case())
-    {
-      boost::algorithm::to_upper(m_find_string);
-    }
+    m_searcher.emplace(
+      m_frd->get_find_string(),
+      m_frd->match_case(),
+      m_frd->match_word());
+  }
+  else if (m_frd->is_regex() && m_write)
+  {
+    m_substitute.emplace(m_frd->get_regex(), m_frd->get_replace_string());
   }
 
   return true;
@@ -174,26 +181,46 @@ int wex::stream::replace_all(std::string& text, int* match_pos)
   return count;
 }
 
-bool wex::stream::run_tool()
+bool wex::stream::run_lines(std::string_view text)
 {
-  std::fstream fs(m_path.data(), std::ios_base::in);
-  if (!fs.is_open())
+  // Only lines that might match are split off and processed, these
+  // contain the find string, or the literal prefix of the regex.
+  const std::string needle(
+    !m_frd->is_regex() ? m_frd->get_find_string() :
+    m_substitute       ? m_substitute->prefix() :
+                         std::string());
+
+  if (!needle.empty() && !text.contains(needle))
   {
-    log("stream::open") << m_path;
-    return false;
+    return true;
   }
 
-  if (!process_begin())
+  std::string out;
+  size_t      copied = 0, line_no = 0, lines = 0;
+
+  for (size_t line_start = 0; line_start < text.size();)
   {
-    return false;
-  }
+    if (!needle.empty())
+    {
+      const auto pos = text.find(needle, line_start);
 
-  m_asked = false;
-  std::string s;
-  int         line_no = 0;
+      if (pos == std::string::npos)
+      {
+        break;
+      }
+
+      line_no += skip_lines(text, line_start, pos);
+    }
+
+    if (m_interruptible && lines++ % 1000 == 0 && !interruptible::is_running())
+    {
+      log::trace("stream::run_tool interrupted") << m_path;
+      return false;
+    }
+
+    const auto  line_end = std::min(text.find('\n', line_start), text.size());
+    std::string line(text.substr(line_start, line_end - line_start));
 
-  for (std::string line; std::getline(fs, line);)
-  {
     if (!process(line, line_no++))
     {
       return false;
@@ -201,33 +228,126 @@ bool wex::stream::run_tool()
 
     if (m_write)
     {
-      s += line + "\n";
+      out.append(text.substr(copied, line_start - copied));
+      out.append(line);
+      copied = line_end;
     }
+
+    line_start = line_end + 1;
   }
 
-  if (m_write && s.empty())
+  if (!m_modified || !m_write)
   {
-    log("stream processing error") << m_path;
-    return false;
+    return true;
   }
 
-  if (m_modified && m_write)
+  out.append(text.substr(copied));
+
+  return write(out);
+}
+
+bool wex::stream::run_searcher(std::string_view text)
+{
+  size_t line_no = 0, line_start = 0;
+
+  for (size_t pos = 0;
+       (pos = m_searcher->find(text, pos)) != std::string::npos;)
   {
-    fs.close();
-    fs.open(m_path.data(), std::ios_base::out);
-    if (!fs.is_open())
+    if (m_interruptible && !interruptible::is_running())
     {
+      log::trace("stream::run_tool interrupted") << m_path;
       return false;
     }
 
-    fs.write(s.c_str(), s.size());
+    line_no += skip_lines(text, line_start, pos);
+
+    const auto line_end = std::min(text.find('\n', line_start), text.size());
+
+    // A match crossing the end of line is no match.
+    if (
+      pos + m_searcher->size() <= line_end &&
+      !process_match(
+        std::string(text.substr(line_start, line_end - line_start)),
+        line_no,
+        pos - line_start,
+        1))
+    {
+      return false;
+    }
 
-    if (factory::beautify b(m_path);
-        b.is_active() && b.is_auto() && b.is_supported(m_path))
+    if (line_end == text.size())
     {
-      fs.close();
-      b.file(m_path);
+      break;
     }
+
+    pos = line_end + 1;
+  }
+
+  return true;
+}
+
+bool wex::stream::run_tool()
+{
+  std::fstream fs(m_path.data(), std::ios_base::in);
+  if (!fs.is_open())
+  {
+    log("stream::open") << m_path;
+    return false;
+  }
+
+  if (!process_begin())
+  {
+    return false;
+  }
+
+  m_asked = false;
+
+  // Reads the file at once, a file without match costs only this read,
+  // and only lines around matches are split off.
+  fs.seekg(0, std::ios::end);
+  const auto  size = std::max<std::streamoff>(fs.tellg(), 0);
+  std::string buffer(static_cast<size_t>(size), 0);
+  fs.seekg(0);
+  fs.read(buffer.data(), buffer.size());
+  buffer.resize(fs.gcount());
+
+  return m_searcher ? run_searcher(buffer) : run_lines(buffer);
+}
+
+bool wex::stream::write(const std::string& text) const
+{
+  // Writes to a temp file next to the file, and renames it over
+  // the file, so the file is replaced at once.
+  std::error_code ec;
+
+  const auto target(std::filesystem::canonical(m_path.data(), ec));
+  const auto& dest(ec ? m_path.data() : target);
+  const std::filesystem::path tmp(dest.string() + ".wex-tmp");
+
+  if (std::ofstream fs(tmp, std::ios_base::out);
+      !fs.is_open() || !fs.write(text.data(), text.size()))
+  {
+    log("stream::write") << tmp.string();
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+
+  std::filesystem::permissions(
+    tmp,
+    std::filesystem::status(dest, ec).permissions(),
+    ec);
+
+  if (std::filesystem::rename(tmp, dest, ec); ec)
+  {
+    log("stream::rename") << dest.string() << ec.message();
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+
+  if (factory::beautify b(m_path);
+      b.is_active() && b.is_auto() && b.is_supported(m_path))
+  {
+    b.file(m_path);
   }
 
   return true;
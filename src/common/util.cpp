@@ -8,6 +8,7 @@
 #include <numeric>
 
 #include <wex/common/dir.h>
+#include <wex/common/match-ring.h>
 #include <wex/common/tostring.h>
 #include <wex/common/util.h>
 #include <wex/core/config.h>
@@ -25,6 +26,7 @@
 #include <wex/syntax/stc.h>
 #include <wex/syntax/util.h>
 #include <wx/app.h>
+#include <wx/thread.h>
 #include <wx/wupdlock.h>
 
 namespace wex
@@ -372,6 +374,17 @@ int wex::open_files(
 
 void wex::process_match(const path_match& m, wxEvtHandler* eh)
 {
+  // From a find thread, a match is delivered using the ring of the
+  // event handler, if present.
+  if (!wxThread::IsMain())
+  {
+    if (const auto& ring(match_ring::get(eh)); ring != nullptr)
+    {
+      ring->push(m);
+      return;
+    }
+  }
+
   wxCommandEvent event(wxEVT_COMMAND_MENU_SELECTED, ID_LIST_MATCH);
   event.SetClientData(new path_match(m));
   wxPostEvent(eh, event);
@@ -7,6 +7,7 @@
 
 #include <wex/core/app.h>
 #include <wex/core/config.h>
+#include <wex/core/file-watcher.h>
 #include <wex/core/log.h>
 #include <wx/clipbrd.h>
 
@@ -16,6 +17,7 @@
 #endif
 
 #include <iostream>
+#include <vector>
 
 #include "app-locale.h"
 
@@ -31,10 +33,22 @@ int first_init()
 
   return 1;
 }
+
+// The callbacks added by app::add_exit.
+std::vector<std::function<void()>>& exits()
+{
+  static std::vector<std::function<void()>> v;
+  return v;
+}
 } // namespace wex
 
 int wex::app::m_first_init = first_init();
 
+void wex::app::add_exit(std::function<void()> f)
+{
+  exits().emplace_back(std::move(f));
+}
+
 const wxUILocale& wex::app::get_locale()
 {
   return wxUILocale::GetCurrent();
@@ -44,7 +58,15 @@ int wex::app::OnExit()
 {
   try
   {
+    for (const auto& f : exits())
+    {
+      f();
+    }
+
+    exits().clear();
+
     config::on_exit();
+    file_watcher::on_exit();
 
     log::info("exit");
   }
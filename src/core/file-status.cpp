@@ -48,6 +48,11 @@ time_t wex::file_status::get_creation_time() const
   return m_file_status.st_ctime;
 }
 
+ino_t wex::file_status::get_inode() const
+{
+  return m_file_status.st_ino;
+}
+
 time_t wex::file_status::get_modification_time() const
 {
   return m_file_status.st_mtime;
@@ -0,0 +1,619 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      file-watcher.cpp
+// Purpose:   Implementation of class wex::file_watcher
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/core/file-watcher.h>
+#include <wex/core/log.h>
+#include <wx/app.h>
+
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace wex
+{
+// The state of the file watcher, the paths are watched by
+// watching their parent dirs, and filtering on the subscribed paths.
+class watcher
+{
+public:
+  static watcher& get()
+  {
+    static watcher w;
+    return w;
+  }
+
+  bool add(size_t id, const path& p)
+  {
+    std::lock_guard lock(m_mutex);
+
+    const auto& it = m_subscriptions.find(id);
+
+    if (it == m_subscriptions.end() || p.empty())
+    {
+      return false;
+    }
+
+    if (const auto& key(normal(p)); !it->second.paths.contains(key))
+    {
+      if (!watch(key))
+      {
+        return false;
+      }
+
+      it->second.paths.insert(key);
+    }
+
+    return true;
+  }
+
+  void clear(size_t id)
+  {
+    std::lock_guard lock(m_mutex);
+
+    if (const auto& it = m_subscriptions.find(id); it != m_subscriptions.end())
+    {
+      for (const auto& key : it->second.paths)
+      {
+        release(key);
+      }
+
+      it->second.paths.clear();
+    }
+  }
+
+  bool is_supported()
+  {
+    std::lock_guard lock(m_mutex);
+    return start();
+  }
+
+  static std::string normal(const path& p)
+  {
+    // Symlinks are resolved, so the dir of the target is watched.
+    std::error_code ec;
+    const auto&     a(std::filesystem::absolute(p.data(), ec));
+
+    if (ec)
+    {
+      return p.data().lexically_normal().string();
+    }
+
+    const auto& c(std::filesystem::weakly_canonical(a, ec));
+    return (ec ? a.lexically_normal() : c).string();
+  }
+
+  bool set(size_t id, const std::vector<path>& v)
+  {
+    std::set<std::string> keys;
+
+    for (const auto& p : v)
+    {
+      if (!p.empty())
+      {
+        keys.insert(normal(p));
+      }
+    }
+
+    std::lock_guard lock(m_mutex);
+
+    const auto& it = m_subscriptions.find(id);
+
+    if (it == m_subscriptions.end())
+    {
+      return false;
+    }
+
+    // Watch the new paths before releasing the old ones,
+    // so dirs that are still used are not watched again.
+    std::set<std::string> watched;
+    bool                  ok = true;
+
+    for (const auto& key : keys)
+    {
+      if (it->second.paths.contains(key) || watch(key))
+      {
+        watched.insert(key);
+      }
+      else
+      {
+        ok = false;
+      }
+    }
+
+    for (const auto& key : it->second.paths)
+    {
+      if (!keys.contains(key))
+      {
+        release(key);
+      }
+    }
+
+    it->second.paths = std::move(watched);
+
+    return ok;
+  }
+
+  void stop()
+  {
+#ifdef __linux__
+    {
+      std::lock_guard lock(m_mutex);
+
+      if (m_stopped)
+      {
+        return;
+      }
+
+      m_stopped = true;
+
+      if (m_fd != -1)
+      {
+        const uint64_t one = 1;
+        [[maybe_unused]] const auto r = write(m_stop, &one, sizeof(one));
+      }
+    }
+
+    if (m_thread.joinable())
+    {
+      m_thread.join();
+    }
+
+    if (m_fd != -1)
+    {
+      close(m_fd);
+      close(m_stop);
+      m_fd = -1;
+    }
+#endif
+  }
+
+  size_t subscribe(file_watcher::changed_t f)
+  {
+    std::lock_guard lock(m_mutex);
+
+    if (!start())
+    {
+      return 0;
+    }
+
+    m_subscriptions.emplace(m_id, subscription{std::move(f), {}});
+
+    return m_id++;
+  }
+
+  void unsubscribe(size_t id)
+  {
+    clear(id);
+
+    std::lock_guard lock(m_mutex);
+    m_subscriptions.erase(id);
+  }
+
+private:
+  struct subscription
+  {
+    file_watcher::changed_t f;
+    std::set<std::string>   paths;
+  };
+
+  struct dir
+  {
+    int    wd;
+    size_t refs;
+  };
+
+  ~watcher() { stop(); }
+
+#ifdef __linux__
+  int add_watch(const std::string& name)
+  {
+    return inotify_add_watch(
+      m_fd,
+      name.c_str(),
+      IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF |
+        IN_MODIFY | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO);
+  }
+#endif
+
+  // Adds the paths in the dir to the pending paths.
+  void changed_dir(const std::string& name)
+  {
+    for (const auto& it : m_paths)
+    {
+      if (std::filesystem::path(it.first).parent_path() == name)
+      {
+        m_pending.insert(it.first);
+      }
+    }
+  }
+
+  // Invoked on the main thread, invokes the subscribers of the paths
+  // that changed since last delivery.
+  void deliver()
+  {
+    std::vector<std::pair<size_t, std::string>> changes;
+
+    {
+      std::lock_guard lock(m_mutex);
+
+      m_posted = false;
+
+      for (const auto& key : m_pending)
+      {
+        for (const auto& [id, s] : m_subscriptions)
+        {
+          if (s.paths.contains(key))
+          {
+            changes.emplace_back(id, key);
+          }
+        }
+      }
+
+      m_pending.clear();
+    }
+
+    for (const auto& [id, key] : changes)
+    {
+      file_watcher::changed_t f;
+
+      {
+        // A subscriber might unsubscribe while delivering.
+        std::lock_guard lock(m_mutex);
+
+        if (const auto& it = m_subscriptions.find(id);
+            it != m_subscriptions.end())
+        {
+          f = it->second.f;
+        }
+      }
+
+      if (f != nullptr)
+      {
+        f(path(key));
+      }
+    }
+  }
+
+  // The dir of the watch is removed or moved, the paths in it
+  // are changed, and the dir is watched again when present.
+  void lose(int wd)
+  {
+#ifdef __linux__
+    const auto& it = m_wds.find(wd);
+
+    if (it == m_wds.end())
+    {
+      return;
+    }
+
+    const auto name(it->second);
+
+    // A moved dir is still watched, under its new name.
+    inotify_rm_watch(m_fd, wd);
+    m_wds.erase(it);
+
+    if (const auto& d = m_dirs.find(name); d != m_dirs.end())
+    {
+      d->second.wd = -1;
+      m_lost.insert(name);
+    }
+
+    changed_dir(name);
+#endif
+  }
+
+  void post()
+  {
+    m_posted = true;
+
+    wxTheApp->CallAfter(
+      [this]
+      {
+        deliver();
+      });
+  }
+
+  void release(const std::string& key)
+  {
+    if (const auto& it = m_paths.find(key);
+        it != m_paths.end() && --it->second == 0)
+    {
+      m_paths.erase(it);
+    }
+
+#ifdef __linux__
+    if (const auto& it =
+          m_dirs.find(std::filesystem::path(key).parent_path().string());
+        it != m_dirs.end() && --it->second.refs == 0)
+    {
+      if (it->second.wd != -1)
+      {
+        inotify_rm_watch(m_fd, it->second.wd);
+        m_wds.erase(it->second.wd);
+      }
+      else
+      {
+        m_lost.erase(it->first);
+      }
+
+      m_dirs.erase(it);
+    }
+#endif
+  }
+
+  // Watches the lost dirs that are present again, returns true
+  // if paths are changed.
+  bool rewatch()
+  {
+#ifdef __linux__
+    bool changed = false;
+
+    for (auto it = m_lost.begin(); it != m_lost.end();)
+    {
+      if (const auto wd = add_watch(*it); wd == -1)
+      {
+        ++it;
+      }
+      else
+      {
+        m_dirs[*it].wd = wd;
+        m_wds[wd]      = *it;
+        changed_dir(*it);
+        it      = m_lost.erase(it);
+        changed = true;
+      }
+    }
+
+    return changed && !m_pending.empty();
+#else
+    return false;
+#endif
+  }
+
+  // Reads inotify events until stopped, the changed paths are collected
+  // and delivered at once.
+  void run()
+  {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[64 * 1024];
+
+    while (true)
+    {
+      pollfd fds[2]{{m_fd, POLLIN, 0}, {m_stop, POLLIN, 0}};
+
+      int timeout = -1;
+
+      {
+        // Lost dirs are watched again as soon as present.
+        std::lock_guard lock(m_mutex);
+
+        if (!m_lost.empty() && rewatch() && !m_posted && wxTheApp != nullptr)
+        {
+          post();
+        }
+
+        timeout = m_lost.empty() ? -1 : 1000;
+      }
+
+      if (poll(fds, 2, timeout) < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+
+        log("file watcher poll") << errno;
+        return;
+      }
+
+      if (fds[1].revents != 0)
+      {
+        return;
+      }
+
+      if (fds[0].revents == 0)
+      {
+        continue;
+      }
+
+      const auto n = read(m_fd, buffer, sizeof(buffer));
+
+      if (n <= 0)
+      {
+        continue;
+      }
+
+      std::lock_guard lock(m_mutex);
+
+      for (ssize_t i = 0; i < n;)
+      {
+        const auto* e = reinterpret_cast<const inotify_event*>(buffer + i);
+        i += sizeof(inotify_event) + e->len;
+
+        if (e->mask & IN_Q_OVERFLOW)
+        {
+          // Events are lost, all paths might be changed.
+          for (const auto& it : m_paths)
+          {
+            m_pending.insert(it.first);
+          }
+        }
+        else if (e->mask & (IN_IGNORED | IN_MOVE_SELF))
+        {
+          lose(e->wd);
+        }
+        else if (const auto& it = m_wds.find(e->wd); it != m_wds.end())
+        {
+          const auto& key(
+            e->len > 0 ?
+              (std::filesystem::path(it->second) / e->name).string() :
+              it->second);
+
+          if (m_paths.contains(key))
+          {
+            m_pending.insert(key);
+          }
+        }
+      }
+
+      if (!m_pending.empty() && !m_posted && wxTheApp != nullptr)
+      {
+        post();
+      }
+    }
+#endif
+  }
+
+  // Starts watching if not yet done, returns false if not supported.
+  bool start()
+  {
+#ifdef __linux__
+    if (m_stopped)
+    {
+      return false;
+    }
+
+    if (m_fd != -1)
+    {
+      return true;
+    }
+
+    if ((m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) == -1)
+    {
+      log("inotify_init1") << errno;
+      m_stopped = true;
+      return false;
+    }
+
+    if ((m_stop = eventfd(0, EFD_CLOEXEC)) == -1)
+    {
+      log("eventfd") << errno;
+      close(m_fd);
+      m_fd      = -1;
+      m_stopped = true;
+      return false;
+    }
+
+    m_thread = std::thread(
+      [this]
+      {
+        run();
+      });
+
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  // Returns false if the dir of the path could not be watched.
+  bool watch(const std::string& key)
+  {
+    if (!watch_dir(std::filesystem::path(key).parent_path().string()))
+    {
+      return false;
+    }
+
+    m_paths[key]++;
+
+    return true;
+  }
+
+  bool watch_dir(const std::string& name)
+  {
+#ifdef __linux__
+    auto& d(m_dirs.try_emplace(name, dir{-1, 0}).first->second);
+
+    if (d.refs == 0)
+    {
+      if ((d.wd = add_watch(name)) == -1)
+      {
+        log::debug("inotify_add_watch") << name << errno;
+        m_dirs.erase(name);
+        return false;
+      }
+
+      m_wds[d.wd] = name;
+    }
+
+    d.refs++;
+
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  std::mutex  m_mutex;
+  std::thread m_thread;
+
+  int m_fd{-1}, m_stop{-1};
+
+  bool m_posted{false}, m_stopped{false};
+
+  size_t m_id{1};
+
+  std::set<std::string> m_lost, m_pending;
+
+  std::unordered_map<std::string, dir>     m_dirs;
+  std::unordered_map<std::string, size_t>  m_paths;
+  std::unordered_map<size_t, subscription> m_subscriptions;
+  std::unordered_map<int, std::string>     m_wds;
+};
+} // namespace wex
+
+bool wex::file_watcher::add(size_t id, const path& p)
+{
+  return watcher::get().add(id, p);
+}
+
+void wex::file_watcher::clear(size_t id)
+{
+  watcher::get().clear(id);
+}
+
+bool wex::file_watcher::is_supported()
+{
+  return watcher::get().is_supported();
+}
+
+wex::path wex::file_watcher::normal(const path& p)
+{
+  return path(watcher::normal(p));
+}
+
+void wex::file_watcher::on_exit()
+{
+  watcher::get().stop();
+}
+
+bool wex::file_watcher::set(size_t id, const std::vector<path>& v)
+{
+  return watcher::get().set(id, v);
+}
+
+size_t wex::file_watcher::subscribe(changed_t f)
+{
+  return watcher::get().subscribe(std::move(f));
+}
+
+void wex::file_watcher::unsubscribe(size_t id)
+{
+  if (id != 0)
+  {
+    watcher::get().unsubscribe(id);
+  }
+}
@@ -6,6 +6,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <wex/core/config.h>
+#include <wex/core/file-watcher.h>
 #include <wex/core/file.h>
 #include <wex/core/log.h>
 
@@ -59,6 +60,11 @@ wex::file::file(const file& rhs)
   *this = rhs;
 }
 
+wex::file::~file()
+{
+  file_watcher::unsubscribe(m_watch_id);
+}
+
 wex::file& wex::file::operator=(const file& f)
 {
   if (this != &f)
@@ -80,6 +86,17 @@ void wex::file::assign(const wex::path& p)
   m_path = p;
   m_stat.sync(m_path.string());
   m_fs = std::fstream(m_path.data());
+
+  if (m_watch_id != 0)
+  {
+    file_watcher::clear(m_watch_id);
+
+    if (!file_watcher::add(m_watch_id, m_path))
+    {
+      file_watcher::unsubscribe(m_watch_id);
+      m_watch_id = 0;
+    }
+  }
 }
 
 bool wex::file::check_sync()
@@ -299,6 +316,31 @@ const std::string* wex::file::read(std::streampos seek_position)
   return m_buffer.get();
 }
 
+bool wex::file::watch(std::function<void()> f)
+{
+  file_watcher::unsubscribe(m_watch_id);
+  m_watch_id = 0;
+
+  if (f == nullptr)
+  {
+    return true;
+  }
+
+  m_watch_id = file_watcher::subscribe(
+    [f = std::move(f)](const wex::path&)
+    {
+      f();
+    });
+
+  if (m_watch_id != 0 && !file_watcher::add(m_watch_id, m_path))
+  {
+    file_watcher::unsubscribe(m_watch_id);
+    m_watch_id = 0;
+  }
+
+  return m_watch_id != 0;
+}
+
 bool wex::file::write(std::span<const char> buffer)
 {
   if (!m_fs.is_open())
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      path-matcher.cpp
+// Purpose:   Implementation of class wex::path_matcher
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/tokenizer.hpp>
+#include <wex/core/log.h>
+#include <wex/core/path-matcher.h>
+
+#include "regex-cache.h"
+
+#include <algorithm>
+
+namespace wex
+{
+// Returns true if text matches the glob, where * matches any
+// sequence of chars, and ? matches zero or one char.
+bool glob_match(const std::string& glob, const std::string& text)
+{
+  // m[j] is true if the glob part so far matches the first j chars.
+  std::vector<bool> m(text.size() + 1, false);
+  m[0] = true;
+
+  for (const auto c : glob)
+  {
+    std::vector<bool> next(text.size() + 1, false);
+
+    for (size_t j = 0; j <= text.size(); j++)
+    {
+      switch (c)
+      {
+        case '*':
+          next[j] = m[j] || (j > 0 && next[j - 1]);
+          break;
+
+        case '?':
+          next[j] = m[j] || (j > 0 && m[j - 1]);
+          break;
+
+        default:
+          next[j] = j > 0 && m[j - 1] && text[j - 1] == c;
+      }
+    }
+
+    m.swap(next);
+  }
+
+  return m.back();
+}
+
+// Returns true if the glob is like *.ext.
+bool is_extension(const std::string& glob)
+{
+  return glob.size() > 2 && glob.starts_with("*.") &&
+         std::ranges::none_of(
+           glob.substr(1),
+           [](const auto c)
+           {
+             return c == '*' || c == '?';
+           });
+}
+} // namespace wex
+
+wex::path_matcher::path_matcher(const std::string& patterns, bool is_regex)
+  : m_all(!is_regex && patterns == "*")
+  , m_patterns(patterns)
+{
+  for (const auto& it : boost::tokenizer<boost::char_separator<char>>(
+         patterns,
+         boost::char_separator<char>(";")))
+  {
+    if (is_regex)
+    {
+      try
+      {
+        m_regex.emplace_back(regex_cache::get().compile(it, boost::regex::perl));
+      }
+      catch (boost::regex_error& e)
+      {
+        log::status() << e.what();
+      }
+    }
+    else if (is_extension(it))
+    {
+      m_extensions.emplace(it.substr(1));
+    }
+    else
+    {
+      m_globs.emplace_back(it);
+    }
+  }
+}
+
+bool wex::path_matcher::matches(const std::string& fullname) const
+{
+  if (m_all)
+  {
+    return true; // asterix matches always
+  }
+
+  if (fullname.empty())
+  {
+    return false; // empty string never matches
+  }
+
+  if (!m_extensions.empty())
+  {
+    for (auto pos = fullname.find('.'); pos != std::string::npos;
+         pos      = fullname.find('.', pos + 1))
+    {
+      if (m_extensions.contains(fullname.substr(pos)))
+      {
+        return true;
+      }
+    }
+  }
+
+  return std::ranges::any_of(
+           m_globs,
+           [&fullname](const auto& glob)
+           {
+             return glob_match(glob, fullname);
+           }) ||
+         std::ranges::any_of(
+           m_regex,
+           [&fullname](const auto& r)
+           {
+             return boost::regex_search(fullname, r);
+           });
+}
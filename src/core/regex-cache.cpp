@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      regex-cache.cpp
+// Purpose:   Implementation of class wex::regex_cache
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include "regex-cache.h"
+
+wex::regex_cache& wex::regex_cache::get()
+{
+  static regex_cache cache;
+  return cache;
+}
+
+wex::regex_cache::regex_cache(size_t max_size)
+  : m_max_size(max_size)
+{
+}
+
+void wex::regex_cache::clear()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_entries.clear();
+  m_map.clear();
+  m_hits   = 0;
+  m_misses = 0;
+}
+
+boost::regex
+wex::regex_cache::compile(const std::string& text, boost::regex::flag_type flags)
+{
+  const auto key(std::to_string(flags) + ":" + text);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (const auto& it = m_map.find(key); it != m_map.end())
+    {
+      // Move to front, as most recently used.
+      m_entries.splice(m_entries.begin(), m_entries, it->second);
+      m_hits++;
+      return it->second->second;
+    }
+  }
+
+  // Compile outside the lock, this might throw.
+  boost::regex r(text, flags);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_misses++;
+
+  if (m_map.contains(key))
+  {
+    return r;
+  }
+
+  m_entries.emplace_front(key, r);
+  m_map.emplace(key, m_entries.begin());
+
+  if (m_entries.size() > m_max_size)
+  {
+    m_map.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+
+  return r;
+}
+
+size_t wex::regex_cache::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      regex-cache.h
+// Purpose:   Declaration of class wex::regex_cache
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <boost/regex.hpp>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace wex
+{
+/// Offers a thread safe least recently used cache of compiled
+/// regular expressions, keyed by expression and flags.
+/// A compiled boost::regex shares its implementation,
+/// so returning a copy is cheap.
+class regex_cache
+{
+public:
+  /// Returns the process wide cache.
+  static regex_cache& get();
+
+  /// Constructor, specify max number of regular expressions.
+  explicit regex_cache(size_t max_size = 512);
+
+  /// Clears the cache and the counters.
+  void clear();
+
+  /// Returns the compiled regular expression, compiles it if
+  /// it is not yet present. Throws boost::regex_error if
+  /// the regular expression is invalid, these are not cached.
+  boost::regex compile(const std::string& text, boost::regex::flag_type flags);
+
+  /// Returns number of hits.
+  size_t hits() const { return m_hits; }
+
+  /// Returns number of misses.
+  size_t misses() const { return m_misses; }
+
+  /// Returns number of cached regular expressions.
+  size_t size() const;
+
+private:
+  typedef std::pair<std::string, boost::regex> entry_t;
+
+  const size_t m_max_size;
+
+  std::atomic<size_t> m_hits{0}, m_misses{0};
+
+  mutable std::mutex                                              m_mutex;
+  std::list<entry_t>                                              m_entries;
+  std::unordered_map<std::string, std::list<entry_t>::iterator> m_map;
+};
+}; // namespace wex
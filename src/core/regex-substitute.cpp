@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      core/regex-substitute.cpp
+// Purpose:   Implementation of class wex::regex_substitute
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/core/log.h>
+#include <wex/core/regex-substitute.h>
+
+#include "regex-cache.h"
+
+#include <cctype>
+
+namespace wex
+{
+// Returns the literal text any match of the regex starts with,
+// or empty string if not known.
+std::string
+literal_prefix(const std::string& regex, boost::regex::flag_type flags)
+{
+  if (
+    (flags & (boost::regex::icase | boost::regex::mod_x)) ||
+    regex.contains('|'))
+  {
+    return std::string();
+  }
+
+  const std::string special("\\^$.|?*+()[]{}");
+  std::string       prefix;
+
+  for (size_t i = regex.starts_with('^') ? 1 : 0; i < regex.size(); i++)
+  {
+    if (special.contains(regex[i]))
+    {
+      // A quantifier makes the previous char optional.
+      if (
+        !prefix.empty() &&
+        (regex[i] == '?' || regex[i] == '*' || regex[i] == '{'))
+      {
+        prefix.pop_back();
+      }
+
+      break;
+    }
+
+    prefix.push_back(regex[i]);
+  }
+
+  return prefix;
+}
+} // namespace wex
+
+wex::regex_substitute::regex_substitute(
+  const std::string&      regex,
+  const std::string&      replacement,
+  boost::regex::flag_type flags)
+  : m_replacement(replacement)
+{
+  try
+  {
+    m_regex  = regex_cache::get().compile(regex, flags);
+    m_prefix = literal_prefix(regex, flags);
+  }
+  catch (boost::regex_error& e)
+  {
+    log(e) << regex << "code:" << static_cast<int>(e.code());
+  }
+
+  compile(replacement);
+}
+
+wex::regex_substitute::regex_substitute(
+  const boost::regex& regex,
+  const std::string&  replacement)
+  : m_regex(regex)
+  , m_replacement(replacement)
+{
+  if (!regex.empty())
+  {
+    m_prefix = literal_prefix(regex.str(), regex.flags());
+  }
+
+  compile(replacement);
+}
+
+void wex::regex_substitute::compile(const std::string& replacement)
+{
+  // Compiles the sed format replacement, as boost::regex_replace
+  // using format_sed would do.
+  std::string literal;
+
+  const auto add_group = [this, &literal](int group)
+  {
+    if (!literal.empty())
+    {
+      m_parts.push_back({-1, literal});
+      literal.clear();
+    }
+
+    m_parts.push_back({group, std::string()});
+  };
+
+  for (size_t i = 0; i < replacement.size(); i++)
+  {
+    if (const auto c = replacement[i]; c == '&')
+    {
+      add_group(0);
+    }
+    else if (c != '\\')
+    {
+      literal.push_back(c);
+    }
+    else if (i + 1 == replacement.size())
+    {
+      // Let boost handle less common escapes.
+      m_format = true;
+      return;
+    }
+    else
+    {
+      switch (const auto e = replacement[++i]; e)
+      {
+        case 'a':
+          literal.push_back('\a');
+          break;
+        case 'e':
+          literal.push_back(27);
+          break;
+        case 'f':
+          literal.push_back('\f');
+          break;
+        case 'n':
+          literal.push_back('\n');
+          break;
+        case 'r':
+          literal.push_back('\r');
+          break;
+        case 't':
+          literal.push_back('\t');
+          break;
+        case 'v':
+          literal.push_back('\v');
+          break;
+        case 'c':
+        case 'x':
+          m_format = true;
+          return;
+        default:
+          if (std::isdigit(static_cast<unsigned char>(e)))
+          {
+            add_group(e - '0');
+          }
+          else
+          {
+            literal.push_back(e);
+          }
+      }
+    }
+  }
+
+  if (!literal.empty())
+  {
+    m_parts.push_back({-1, literal});
+  }
+}
+
+int wex::regex_substitute::replace(
+  std::string_view text,
+  std::string&     out,
+  int*             pos) const
+{
+  if (!is_ok() || (!m_prefix.empty() && !text.contains(m_prefix)))
+  {
+    out.append(text);
+    return 0;
+  }
+
+  int         count = 0;
+  const char* last  = text.data();
+
+  for (boost::cregex_iterator
+         it(text.data(), text.data() + text.size(), m_regex),
+       end;
+       it != end;
+       ++it)
+  {
+    const auto& m(*it);
+
+    if (count++ == 0 && pos != nullptr)
+    {
+      *pos = static_cast<int>(m[0].first - text.data());
+    }
+
+    out.append(last, m[0].first);
+
+    if (m_format)
+    {
+      m.format(
+        std::back_inserter(out),
+        m_replacement,
+        boost::regex_constants::format_sed);
+    }
+    else
+    {
+      for (const auto& part : m_parts)
+      {
+        if (part.group < 0)
+        {
+          out.append(part.text);
+        }
+        else if (
+          part.group < static_cast<int>(m.size()) && m[part.group].matched)
+        {
+          out.append(m[part.group].first, m[part.group].second);
+        }
+      }
+    }
+
+    last = m[0].second;
+  }
+
+  out.append(last, text.data() + text.size());
+
+  return count;
+}
+
+int wex::regex_substitute::replace(std::string& text, int* pos) const
+{
+  std::string out;
+  out.reserve(text.size());
+
+  if (const auto count = replace(std::string_view(text), out, pos); count > 0)
+  {
+    text.swap(out);
+    return count;
+  }
+
+  return 0;
+}
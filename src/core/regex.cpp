@@ -2,7 +2,7 @@
 // Name:      core/regex.cpp
 // Purpose:   Implementation of class wex::regex
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2021-2025 Anton van Wezenbeek
+// Copyright: (c) 2021-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
@@ -10,6 +10,8 @@
 #include <wex/core/log.h>
 #include <wex/core/regex.h>
 
+#include "regex-cache.h"
+
 #define FILL_DATA(TYPE, ACTION)                                                \
   [](const TYPE& reg_v, boost::regex::flag_type flags)                         \
   {                                                                            \
@@ -29,6 +31,16 @@ enum class wex::regex::find_t
   MATCH,
 };
 
+size_t wex::regex::cache_hits()
+{
+  return regex_cache::get().hits();
+}
+
+size_t wex::regex::cache_misses()
+{
+  return regex_cache::get().misses();
+}
+
 wex::regex::regex(const data& d)
   : m_datas({d})
   , m_it(m_datas.end())
@@ -153,7 +165,7 @@ void wex::regex::data::init(
 {
   try
   {
-    m_regex = boost::regex(m_text, flags);
+    m_regex = regex_cache::get().compile(m_text, flags);
   }
   catch (boost::regex_error& e)
   {
@@ -6,13 +6,12 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <boost/algorithm/string.hpp>
-#include <boost/regex.hpp>
-#include <boost/tokenizer.hpp>
 #include <boost/url.hpp>
 
 #include <wex/core/config.h>
 #include <wex/core/core.h>
 #include <wex/core/log.h>
+#include <wex/core/path-matcher.h>
 #include <wex/core/path.h>
 #include <wx/clipbrd.h>
 #include <wx/generic/dirctrlg.h> // for wxFileIconsTable
@@ -197,18 +196,38 @@ size_t wex::get_number_of_lines(const std::string& text, bool trim)
          1;
 }
 
-const std::string wex::get_string_set(
+size_t wex::append_string_set(
+  std::string&                 text,
   const std::set<std::string>& kset,
   size_t                       min_size,
   const std::string&           prefix)
 {
-  return std::ranges::fold_left(
-    kset,
-    std::string{},
-    [&](const std::string& a, const std::string& b)
+  size_t count = 0;
+
+  // The set is sorted, so seek to the first string with the prefix.
+  for (auto it = kset.lower_bound(prefix);
+       it != kset.end() && it->starts_with(prefix);
+       ++it)
+  {
+    if (it->size() >= min_size)
     {
-      return (b.size() >= min_size && b.starts_with(prefix)) ? a + b + ' ' : a;
-    });
+      text.append(*it);
+      text.push_back(' ');
+      count++;
+    }
+  }
+
+  return count;
+}
+
+const std::string wex::get_string_set(
+  const std::set<std::string>& kset,
+  size_t                       min_size,
+  const std::string&           prefix)
+{
+  std::string text;
+  append_string_set(text, kset, min_size, prefix);
+  return text;
 }
 
 int wex::icompare(const std::string& text1, const std::string& text2)
@@ -238,47 +257,7 @@ bool wex::matches_one_of(
   const std::string& pattern,
   bool               is_regex)
 {
-  if (!is_regex && pattern == "*")
-  {
-    return true; // asterix matches always
-  }
-
-  if (filename.empty())
-  {
-    return false; // empty string never matches
-  }
-
-  // Make a regex of pattern matching chars.
-  auto re(pattern);
-
-  if (!is_regex)
-  {
-    boost::algorithm::replace_all(re, ".", "\\.");
-    boost::algorithm::replace_all(re, "*", ".*");
-    boost::algorithm::replace_all(re, "?", ".?");
-  }
-
-  for (const auto& it : boost::tokenizer<boost::char_separator<char>>(
-         re,
-         boost::char_separator<char>(";")))
-  {
-    try
-    {
-      if (
-        !is_regex && boost::regex_match(filename, boost::regex(it)) ||
-        is_regex && boost::regex_search(filename, boost::regex(it)))
-      {
-        return true;
-      }
-    }
-    catch (boost::regex_error& e)
-    {
-      log::status() << e.what();
-      return false;
-    }
-  }
-
-  return false;
+  return path_matcher(pattern, is_regex).matches(filename);
 }
 
 const std::string wex::quoted(const std::string& text, char delim)
@@ -125,6 +125,12 @@ wex::data::listview::menu(menu_t flags, data::control::action_t action)
   return *this;
 }
 
+wex::data::listview& wex::data::listview::owner_data(bool rhs)
+{
+  m_is_owner_data = rhs;
+  return *this;
+}
+
 wex::data::listview& wex::data::listview::revision(bool rhs)
 {
   m_is_revision = rhs;
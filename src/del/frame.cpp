@@ -7,7 +7,6 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim_all.hpp>
-#include <boost/tokenizer.hpp>
 #include <sstream>
 #include <wex/wex.h>
 #include <wx/timer.h>
@@ -134,6 +133,25 @@ wex::del::frame::frame(
           }
         }
       })
+  , m_blame_cache(
+      [this](const wex::path& p)
+      {
+        CallAfter(
+          [this, p]
+          {
+            // The blame is ready, update the blame panes if still shown.
+            if (auto* stc = get_stc(); stc != nullptr && stc->path() == p)
+            {
+              for (const auto& pane : panes_blame_format())
+              {
+                if (get_statusbar()->pane_is_shown(pane.first))
+                {
+                  update_statusbar(stc, pane.first);
+                }
+              }
+            }
+          });
+      })
 {
   auto info(m_info);
   // Match whole word does not work with replace.
@@ -918,23 +936,12 @@ std::string wex::del::frame::vcs_annotate_line(
     return std::string();
   }
 
-  wex::log_none off; // prevent log errors, such as illegal line
-  wex::vcs      vcs{{stc->path()}};
-
-  if (
-    const auto& line(std::to_string(stc->get_current_line() + 1));
-    vcs.execute("blame -L " + line + "," + line + " " + stc->path().string()))
+  // If the file is not yet blamed, the pane is updated when it is.
+  if (const auto& c(m_blame_cache.find(stc->path(), stc->get_current_line()));
+      c)
   {
-    off.enable();
-
-    if (
-      const auto& commit_hash(find_before(vcs.entry().std_out(), " "));
-      !commit_hash.starts_with("000000") &&
-      vcs.execute(
-        "log " + commit_hash + " -n 1 --date=short --format=" + it->second))
-    {
-      return boost::algorithm::trim_all_copy(vcs.entry().std_out());
-    }
+    return boost::algorithm::trim_all_copy(
+      blame_cache::format(*c, it->second));
   }
 
   return std::string();
@@ -1020,48 +1027,70 @@ bool wex::del::frame::vcs_blame_show(vcs_entry* vcs, syntax::stc* stc)
   log::trace("blame show") << vcs->name();
 
   const bool  is_empty(stc->GetTextLength() == 0);
-  std::string prev("!@#$%");
+  std::string prev("!@#$%"), text;
   stc->SetWrapMode(wxSTC_WRAP_NONE);
   wex::blame* blame = &vcs->get_blame();
   bool        first = true;
 
-  blame->line_no(-1);
-  int ex_line_no = 0;
-
-  for (const auto& it : boost::tokenizer<boost::char_separator<char>>(
-         vcs->std_out(),
-         boost::char_separator<char>("\r\n")))
+  struct margin
   {
-    blame->parse(stc->path(), it);
+    int                   line;
+    blame::margin_style_t style;
+    std::string           info;
+  };
+
+  std::vector<margin> margins;
 
+  const auto parsed = [&](wex::blame& b)
+  {
     if (first)
     {
-      stc->blame_margin(blame);
+      stc->blame_margin(&b);
       first = false;
     }
 
-    if (blame->info() != prev)
+    if (b.info() != prev)
     {
-      prev = blame->info();
+      prev = b.info();
     }
     else
     {
-      blame->skip_info(true);
+      b.skip_info(true);
     }
 
     if (!stc->is_visual())
     {
-      blame->line_no(ex_line_no++);
+      b.line_no(static_cast<int>(margins.size()));
     }
 
     if (is_empty)
     {
-      stc->add_text(blame->line_text() + "\n");
+      text.append(b.line_text()).append("\n");
     }
 
-    lexers::get()->apply_margin_text_style(stc, blame);
+    margins.push_back(
+      {b.line_no(), b.style(), b.skip_info() ? std::string() : b.info()});
+  };
+
+  blame->line_no(-1);
+  blame->stream_begin(stc->path());
+  blame->stream(vcs->std_out(), parsed);
+  blame->stream_end(parsed);
+
+  // The text and margins are set in one pass after parsing.
+  if (is_empty)
+  {
+    stc->add_text(text);
   }
 
+  for (const auto& m : margins)
+  {
+    lexers::get()->apply_margin_text_style(stc, m.line, m.style, m.info);
+  }
+
+  // Blames the file for the blame panes as well.
+  m_blame_cache.find(stc->path(), stc->get_current_line());
+
   return true;
 }
 
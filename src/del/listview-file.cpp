@@ -34,6 +34,15 @@ wex::del::file::file(const wex::path& p, const data::listview& data)
 
   path().set_log(path::log_t().set(path::LOG_MOD));
 
+  watch(
+    [this]
+    {
+      if (config("AllowSync").get(true))
+      {
+        check_sync();
+      }
+    });
+
   Bind(wxEVT_IDLE, &del::file::on_idle, this);
 
   Bind(
@@ -296,7 +305,9 @@ void wex::del::file::on_idle(wxIdleEvent& event)
 {
   event.Skip();
 
-  if (IsShown() && GetItemCount() > 0 && config("AllowSync").get(true))
+  if (
+    !is_watched() && IsShown() && GetItemCount() > 0 &&
+    config("AllowSync").get(true))
   {
     check_sync();
   }
@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      command-index.cpp
+// Purpose:   Implementation of class wex::command_index
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cctype>
+
+#include "command-index.h"
+
+namespace wex
+{
+// Returns the first char a regular expression requires after
+// the anchored colon, or nullopt if the regular expression
+// might match otherwise.
+std::optional<unsigned char> first_char(const std::string& regex)
+{
+  std::optional<unsigned char> result;
+  std::vector<std::string>     alternatives(1);
+  int                          depth = 0;
+
+  for (size_t i = 0; i < regex.size(); i++)
+  {
+    const auto c = regex[i];
+
+    if (c == '\\' && i + 1 < regex.size())
+    {
+      alternatives.back() += regex.substr(i++, 2);
+      continue;
+    }
+
+    if (c == '(' || c == '[')
+    {
+      depth++;
+    }
+    else if ((c == ')' || c == ']') && depth > 0)
+    {
+      depth--;
+    }
+    else if (c == '|' && depth == 0)
+    {
+      alternatives.emplace_back();
+      continue;
+    }
+
+    alternatives.back() += c;
+  }
+
+  for (const auto& a : alternatives)
+  {
+    // The alternative should be like ^:x, where x is not optional.
+    if (
+      a.size() < 3 || !a.starts_with("^:") ||
+      !std::isalpha(static_cast<unsigned char>(a[2])) ||
+      (a.size() > 3 && (a[3] == '?' || a[3] == '*' || a[3] == '{')))
+    {
+      return std::nullopt;
+    }
+
+    if (result && *result != static_cast<unsigned char>(a[2]))
+    {
+      return std::nullopt;
+    }
+
+    result = static_cast<unsigned char>(a[2]);
+  }
+
+  return result;
+}
+} // namespace wex
+
+wex::command_index::command_index(const std::vector<std::string>& regex)
+{
+  m_regex.reserve(regex.size());
+
+  for (size_t i = 0; i < regex.size(); i++)
+  {
+    m_regex.emplace_back(regex[i]);
+
+    if (const auto c(first_char(regex[i])); c)
+    {
+      m_index[*c].emplace_back(i);
+    }
+    else
+    {
+      for (auto& v : m_index)
+      {
+        v.emplace_back(i);
+      }
+    }
+  }
+}
+
+std::optional<size_t>
+wex::command_index::find(const std::string& command) const
+{
+  const auto& candidates(
+    command.size() > 1 && command[0] == ':' ?
+      m_index[static_cast<unsigned char>(command[1])] :
+      m_index.back());
+
+  for (const auto i : candidates)
+  {
+    if (boost::regex_search(command, m_regex[i]))
+    {
+      return i;
+    }
+  }
+
+  return std::nullopt;
+}
@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      command-index.h
+// Purpose:   Declaration of class wex::command_index
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <boost/regex.hpp>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace wex
+{
+/// Offers a compiled table of command regular expressions.
+/// The regular expressions are compiled once, and indexed on the
+/// first char after the colon, so only regular expressions that
+/// might match are tried, in table order.
+class command_index
+{
+public:
+  /// Constructor, specify the regular expressions.
+  explicit command_index(const std::vector<std::string>& regex);
+
+  /// Returns the position of the first regular expression that matches
+  /// the command, or nullopt.
+  std::optional<size_t> find(const std::string& command) const;
+
+  /// Returns number of regular expressions.
+  size_t size() const { return m_regex.size(); }
+
+private:
+  std::vector<boost::regex> m_regex;
+
+  // For each first char after the colon the positions to try,
+  // the last entry is used for other commands.
+  std::array<std::vector<size_t>, 257> m_index;
+};
+}; // namespace wex
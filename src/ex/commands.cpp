@@ -16,6 +16,7 @@
 #include <wex/core/log.h>
 #include <wex/core/version.h>
 #include <wex/ctags/ctags.h>
+#include <wex/ex/ex-stream.h>
 #include <wex/ex/ex.h>
 #include <wex/ex/macros.h>
 #include <wex/ex/util.h>
@@ -25,6 +26,8 @@
 #include <wex/ui/frame.h>
 #include <wx/app.h>
 
+#include "command-index.h"
+
 #define POST_COMMAND(ID)                                                       \
   {                                                                            \
     wxCommandEvent event(wxEVT_COMMAND_MENU_SELECTED, ID);                     \
@@ -367,6 +370,22 @@ wex::ex::commands_t wex::ex::commands_ex()
        ctags::find(wex::find_first_of(command, " "));
        return true;
      }},
+    {"^:u(ndo)?\\b",
+     [&](const std::string& command)
+     {
+       if (!get_stc()->is_visual())
+       {
+         return m_ex_stream->undo();
+       }
+
+       if (!get_stc()->CanUndo())
+       {
+         return false;
+       }
+
+       get_stc()->Undo();
+       return true;
+     }},
     {"^:una(bbrev)?\\b",
      [&](const std::string& command)
      {
@@ -405,12 +424,23 @@ wex::ex::commands_t wex::ex::commands_ex()
 
 bool wex::ex::command_handle(const std::string& command) const
 {
-  const auto& it = std::ranges::find_if(
-    m_commands,
-    [command](auto const& e)
+  // The regular expressions are the same for all ex components,
+  // so compile them once.
+  static const command_index index(
+    [this]
     {
-      return boost::regex_search(command, boost::regex(e.first));
-    });
+      std::vector<std::string> v;
+      std::ranges::transform(
+        m_commands,
+        std::back_inserter(v),
+        [](const auto& e)
+        {
+          return e.first;
+        });
+      return v;
+    }());
+
+  const auto& it(index.find(command));
 
-  return it != m_commands.end() && it->second(command);
+  return it && m_commands[*it].second(command);
 }
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ex-stream-index.cpp
+// Purpose:   Implementation of class wex::ex_stream_index
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/core/log.h>
+#include <wex/factory/text-window.h>
+
+#include "ex-stream-index.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bi = boost::interprocess;
+
+wex::ex_stream_index::ex_stream_index(const path& p, size_t max_line_size)
+  : m_max_line_size(max_line_size > 1 ? max_line_size - 1 : 1)
+  , m_path(p)
+{
+  try
+  {
+    // An empty file cannot be mapped, the region constructor throws.
+    m_mapping = bi::file_mapping(p.string().c_str(), bi::read_only);
+    m_region  = bi::mapped_region(m_mapping, bi::read_only);
+    m_region.advise(bi::mapped_region::advice_sequential);
+    m_data = std::string_view(
+      static_cast<const char*>(m_region.get_address()),
+      m_region.get_size());
+  }
+  catch (std::exception& e)
+  {
+    log::trace("ex stream index") << p << e.what();
+    m_data = std::string_view();
+    return;
+  }
+
+  m_offsets.push_back(0);
+
+  m_thread = std::thread(
+    [this]
+    {
+      build();
+    });
+}
+
+wex::ex_stream_index::~ex_stream_index()
+{
+  m_stop = true;
+
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+}
+
+void wex::ex_stream_index::build()
+{
+  size_t offset = 0;
+  int    line   = 0;
+
+  while (offset < m_data.size() && !m_stop)
+  {
+    offset = line_end(offset);
+    line++;
+
+    if (line % step == 0 && offset < m_data.size())
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_offsets.push_back(offset);
+    }
+  }
+
+  if (!m_stop)
+  {
+    m_line_count = line;
+    m_complete   = true;
+
+    log::trace("ex stream index") << "lines" << line << "size"
+                                  << m_data.size();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_built = true;
+  }
+
+  m_built_cv.notify_all();
+}
+
+size_t wex::ex_stream_index::line_begin(int line) const
+{
+  if (!is_ok() || line < 0)
+  {
+    return std::string::npos;
+  }
+
+  size_t offset = 0;
+  int    no     = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (const size_t i = line / step; i < m_offsets.size())
+    {
+      offset = m_offsets[i];
+      no     = i * step;
+    }
+    else if (m_complete)
+    {
+      return std::string::npos;
+    }
+    else
+    {
+      // Not yet indexed, scan from last indexed line.
+      offset = m_offsets.back();
+      no     = (m_offsets.size() - 1) * step;
+    }
+  }
+
+  while (no < line && offset < m_data.size())
+  {
+    offset = line_end(offset);
+    no++;
+  }
+
+  return offset < m_data.size() ? offset : std::string::npos;
+}
+
+int wex::ex_stream_index::line_count() const
+{
+  return m_complete ? m_line_count.load() : LINE_COUNT_UNKNOWN;
+}
+
+int wex::ex_stream_index::line_count_request()
+{
+  if (!is_ok())
+  {
+    return LINE_COUNT_UNKNOWN;
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  m_built_cv.wait(
+    lock,
+    [this]
+    {
+      return m_built;
+    });
+
+  return line_count();
+}
+
+size_t wex::ex_stream_index::line_end(size_t offset) const
+{
+  if (offset >= m_data.size())
+  {
+    return m_data.size();
+  }
+
+  const size_t max = std::min(m_max_line_size, m_data.size() - offset);
+
+  if (const auto* eol = static_cast<const char*>(
+        memchr(m_data.data() + offset, '\n', max));
+      eol != nullptr)
+  {
+    return eol - m_data.data() + 1;
+  }
+
+  if (offset + max < m_data.size())
+  {
+    m_block_mode = true;
+  }
+
+  return offset + max;
+}
+
+int wex::ex_stream_index::line_no(size_t offset) const
+{
+  if (!is_ok())
+  {
+    return LINE_NUMBER_UNKNOWN;
+  }
+
+  size_t pos = 0;
+  int    no  = 0;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto it = std::ranges::upper_bound(m_offsets, offset);
+    const auto i  = std::distance(m_offsets.begin(), it) - 1;
+
+    pos = m_offsets[i];
+    no  = i * step;
+  }
+
+  for (size_t next = line_end(pos); next <= offset && next < m_data.size();
+       next        = line_end(pos))
+  {
+    pos = next;
+    no++;
+  }
+
+  return no;
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ex-stream-index.h
+// Purpose:   Declaration of class wex::ex_stream_index
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wex/core/path.h>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace wex
+{
+/// Offers a memory mapped file with a sparse line offset index.
+/// The index is built once by a background thread, it contains
+/// the offset of each step'th line. Lines that are not (yet) indexed
+/// are found by scanning from the nearest indexed line.
+/// Lines without eol within max line size are split,
+/// this is block mode, as in ex_stream.
+class ex_stream_index
+{
+public:
+  /// Number of lines between two indexed offsets.
+  static constexpr int step = 64;
+
+  /// Constructor, maps the file and starts building the index.
+  ex_stream_index(const path& p, size_t max_line_size);
+
+  /// Destructor, stops building the index.
+  ~ex_stream_index();
+
+  /// Returns the mapped data.
+  std::string_view data() const { return m_data; }
+
+  /// Returns the path.
+  const path& get_path() const { return m_path; }
+
+  /// Returns true if some line was split, as no eol was
+  /// found within max line size.
+  bool is_block_mode() const { return m_block_mode; }
+
+  /// Returns true if the index is completely built.
+  bool is_complete() const { return m_complete; }
+
+  /// Returns true if file is mapped.
+  bool is_ok() const { return !m_data.empty(); }
+
+  /// Returns offset of the begin of the line,
+  /// or std::string::npos if line is not present.
+  size_t line_begin(int line) const;
+
+  /// Returns number of lines, or LINE_COUNT_UNKNOWN
+  /// if index is not yet complete.
+  int line_count() const;
+
+  /// Returns number of lines, waits for the index to be complete.
+  /// The thread is only joined by the destructor, so this can be invoked
+  /// from several threads.
+  int line_count_request();
+
+  /// Returns offset after the line that begins at offset,
+  /// this includes the eol.
+  size_t line_end(size_t offset) const;
+
+  /// Returns the line that contains the offset.
+  int line_no(size_t offset) const;
+
+private:
+  void build();
+
+  const size_t m_max_line_size;
+  const path   m_path;
+
+  boost::interprocess::file_mapping  m_mapping;
+  boost::interprocess::mapped_region m_region;
+
+  std::string_view m_data;
+
+  std::vector<size_t>     m_offsets;
+  mutable std::mutex      m_mutex;
+  std::condition_variable m_built_cv;
+  bool                    m_built{false};
+
+  mutable std::atomic<bool> m_block_mode{false};
+  std::atomic<bool>         m_complete{false}, m_stop{false};
+  std::atomic<int>          m_line_count{0};
+
+  std::thread m_thread;
+};
+}; // namespace wex
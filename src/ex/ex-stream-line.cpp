@@ -2,13 +2,13 @@
 // Name:      ex-stream-line.cpp
 // Purpose:   Implementation of class wex::ex_stream_line
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2020-2025 Anton van Wezenbeek
+// Copyright: (c) 2020-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 #include <wex/core/log.h>
-#include <wex/core/regex.h>
 #include <wex/ex/ex.h>
 #include <wex/ex/macros.h>
 #include <wex/ex/util.h>
@@ -35,6 +35,10 @@ wex::ex_stream_line::ex_stream_line(
       type != ACTION_JOIN ? range.end().get_line() - 1 :
                             range.end().get_line() - 2)
 {
+  if (m_action == ACTION_SUBSTITUTE)
+  {
+    m_substitute.emplace(m_data.pattern(), m_data.replacement());
+  }
 }
 
 wex::ex_stream_line::ex_stream_line(
@@ -86,6 +90,12 @@ wex::ex_stream_line::ex_stream_line(
 
 wex::ex_stream_line::~ex_stream_line()
 {
+  // The yanked lines are collected, and set to the register at once.
+  if (m_action == ACTION_YANK)
+  {
+    ex::get_macros().set_register(m_register, m_copy);
+  }
+
   using boost::describe::operators::operator<<;
   std::stringstream ss;
   ss << boost::describe::enum_to_string(m_action, "none") << " " << *this << " "
@@ -93,16 +103,22 @@ wex::ex_stream_line::~ex_stream_line()
   log::trace("ex stream") << ss;
 }
 
+void wex::ex_stream_line::copy_rest(std::span<const char> block)
+{
+  m_file->write(block);
+  m_line += std::ranges::count(block, '\n');
+}
+
 wex::ex_stream_line::handle_t
-wex::ex_stream_line::handle(char* line, size_t& pos)
+wex::ex_stream_line::handle(const char* line, size_t size)
 {
   if (m_line >= m_begin && m_line <= m_end)
   {
     switch (m_action)
     {
       case ACTION_COPY:
-        m_file->write(std::span{line, pos});
-        m_copy.append(line, pos);
+        write(std::span{line, size});
+        m_copy.append(line, size);
         m_actions++;
         break;
 
@@ -118,12 +134,12 @@ wex::ex_stream_line::handle(char* line, size_t& pos)
         }
         if (m_text.contains("l"))
         {
-          m_copy.append(line, pos - 1);
+          m_copy.append(line, size - 1);
           m_copy.append("$\n");
         }
         else
         {
-          m_copy.append(line, pos);
+          m_copy.append(line, size);
         }
 
         m_actions++;
@@ -131,34 +147,32 @@ wex::ex_stream_line::handle(char* line, size_t& pos)
 
       case ACTION_INSERT:
         m_actions++;
-        m_file->write(m_text);
-        m_file->write(std::span{line, pos});
+        write(m_text);
+        write(std::span{line, size});
         break;
 
       case ACTION_JOIN:
         // join: do not write last char, that is \n
         m_actions++;
-        m_file->write(std::span{line, pos - 1});
+        write(std::span{line, size - 1});
         break;
 
       case ACTION_MOVE:
-        m_copy.append(line, pos);
+        m_copy.append(line, size);
         m_actions++;
         break;
 
       case ACTION_SUBSTITUTE:
-        handle_substitute(line, pos);
+        handle_substitute(line, size);
         break;
 
       case ACTION_WRITE:
         m_actions++;
-        m_file->write(std::span{line, pos});
+        write(std::span{line, size});
         break;
 
       case ACTION_YANK:
-        ex::get_macros().set_register(
-          m_register,
-          ex::get_macros().get_register(m_register) + std::string(line, pos));
+        m_copy.append(line, size);
         m_actions++;
         break;
 
@@ -167,13 +181,17 @@ wex::ex_stream_line::handle(char* line, size_t& pos)
         break;
     }
   }
+  else if (m_file == nullptr && m_line > m_end)
+  {
+    return HANDLE_STOP;
+  }
   else
   {
     switch (m_action)
     {
       case ACTION_COPY:
       case ACTION_MOVE:
-        m_file->write(std::span{line, pos});
+        write(std::span{line, size});
 
         if (m_line > m_dest && !m_copy.empty())
         {
@@ -182,10 +200,8 @@ wex::ex_stream_line::handle(char* line, size_t& pos)
         }
         break;
 
-      case ACTION_WRITE:
-        break;
-
       case ACTION_GET:
+      case ACTION_WRITE:
       case ACTION_YANK:
         if (m_line > m_end)
         {
@@ -194,27 +210,43 @@ wex::ex_stream_line::handle(char* line, size_t& pos)
         break;
 
       default:
-        m_file->write(std::span{line, pos});
+        write(std::span{line, size});
     }
   }
 
-  pos = 0;
   m_line++;
 
-  return HANDLE_CONTINUE;
+  // All lines after the range (and destination) remain unchanged.
+  return m_file != nullptr && is_write() && m_action != ACTION_WRITE &&
+             m_line > m_end && m_line > m_dest + 1 && m_copy.empty() ?
+           HANDLE_COPY_REST :
+           HANDLE_CONTINUE;
 }
 
-// cppcheck gives incorrect warning here
-void wex::ex_stream_line::handle_substitute(char* line, size_t pos)
+void wex::ex_stream_line::handle_substitute(const char* line, size_t size)
 {
-  std::string text(line, pos);
+  m_work.clear();
 
   // if regex matches replace text with replacement
-  if (regex r(m_data.pattern()); r.search(text) != -1)
+  if (m_substitute->replace(std::string_view(line, size), m_work) > 0)
   {
-    r.replace(text, m_data.replacement());
     m_actions++;
+    write(m_work);
+  }
+  else
+  {
+    write(std::span{line, size});
   }
+}
 
-  m_file->write(text);
+void wex::ex_stream_line::write(std::span<const char> text)
+{
+  if (m_file != nullptr)
+  {
+    m_file->write(text);
+  }
+  else
+  {
+    m_copy.append(text.data(), text.size());
+  }
 }
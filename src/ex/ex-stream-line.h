@@ -2,15 +2,18 @@
 // Name:      ex-stream-line.h
 // Purpose:   Declaration of class wex::ex_stream_line
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2020-2025 Anton van Wezenbeek
+// Copyright: (c) 2020-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
 
 #include <wex/core/file.h>
+#include <wex/core/regex-substitute.h>
 #include <wex/data/substitute.h>
 #include <wex/ex/addressrange.h>
 
+#include <optional>
+
 namespace wex
 {
 class ex_stream_line
@@ -32,6 +35,7 @@ public:
   enum handle_t
   {
     HANDLE_CONTINUE,
+    HANDLE_COPY_REST, ///< all next lines are copied unchanged
     HANDLE_ERROR,
     HANDLE_STOP,
   };
@@ -60,6 +64,8 @@ public:
 
   /// Constructor for other actions.
   /// Used as delegate constructor.
+  /// If work is nullptr, the written lines are kept in copy
+  /// and handling stops after the range.
   ex_stream_line(
     file*               work,
     action_t            type,
@@ -81,8 +87,16 @@ public:
   /// Returns copy value.
   auto& copy() const { return m_copy; }
 
-  /// Handles a line.
-  handle_t handle(char* line, size_t& pos);
+  /// Copies a block of remaining lines unchanged,
+  /// allowed after handle returned HANDLE_COPY_REST.
+  void copy_rest(std::span<const char> block);
+
+  /// Sets the line the first handled line refers to,
+  /// default the first line.
+  void first_line(int line) { m_line = line; }
+
+  /// Handles a line, size includes the eol (if present).
+  handle_t handle(const char* line, size_t size);
 
   /// Returns true if action is allowed to write.
   bool is_write() const
@@ -94,7 +108,8 @@ public:
   int lines() const { return m_line; }
 
 private:
-  void handle_substitute(char* line, size_t pos);
+  void handle_substitute(const char* line, size_t size);
+  void write(std::span<const char> text);
 
   const action_t         m_action;
   const data::substitute m_data;
@@ -105,7 +120,10 @@ private:
   file* m_file;
   int   m_actions{0}, m_line{0};
 
-  std::string m_copy;
+  std::string m_copy, m_work;
+
+  // Compiled once, for ACTION_SUBSTITUTE.
+  std::optional<regex_substitute> m_substitute;
 
   BOOST_DESCRIBE_CLASS(
     ex_stream_line,
@@ -0,0 +1,559 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ex-stream-pieces.cpp
+// Purpose:   Implementation of class wex::ex_stream_pieces
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/factory/text-window.h>
+
+#include "ex-stream-index.h"
+#include "ex-stream-pieces.h"
+
+#include <algorithm>
+#include <cstring>
+
+wex::ex_stream_pieces::ex_stream_pieces(ex_stream_index& index)
+  : m_index(index)
+{
+  if (!m_index.data().empty())
+  {
+    m_pieces.push_back({false, 0, m_index.data().size(), 0, -1});
+  }
+}
+
+bool wex::ex_stream_pieces::copy(int begin, int end, int dest)
+{
+  size_t first, last;
+
+  if (dest < 0 || split(dest) == std::string::npos ||
+      !split(begin, end, first, last))
+  {
+    return false;
+  }
+
+  const auto to(locate(dest).piece);
+
+  m_undo.push_back(m_pieces);
+
+  std::vector<piece> v(m_pieces.begin() + first, m_pieces.begin() + last);
+
+  // A copied last line without eol gets one, unless copied to the end.
+  if (!has_end(v.back()) && to < m_pieces.size())
+  {
+    v.push_back({true, m_add.size(), 1, 0, 1});
+    m_add.push_back('\n');
+  }
+
+  m_pieces.insert(m_pieces.begin() + to, v.begin(), v.end());
+
+  return true;
+}
+
+int wex::ex_stream_pieces::ends(const piece& p, size_t begin, size_t end) const
+{
+  if (p.add)
+  {
+    return std::count(
+      m_add.begin() + p.offset + begin,
+      m_add.begin() + p.offset + end,
+      '\n');
+  }
+
+  // Using the partial index, only the end of an original piece
+  // up to the end of data needs the complete index.
+  const auto before = [&](size_t x)
+  {
+    return x >= p.size ? lines(p, true) :
+                         m_index.line_no(p.offset + x) - p.line;
+  };
+
+  return before(end) - before(begin);
+}
+
+bool wex::ex_stream_pieces::erase(int begin, int end)
+{
+  size_t first, last;
+
+  if (!split(begin, end, first, last))
+  {
+    return false;
+  }
+
+  m_undo.push_back(m_pieces);
+  m_pieces.erase(m_pieces.begin() + first, m_pieces.begin() + last);
+
+  return true;
+}
+
+int wex::ex_stream_pieces::find(int line, bool forward, const search_t& f)
+  const
+{
+  const auto loc(
+    !forward && line == LINE_NUMBER_UNKNOWN ?
+      location{m_pieces.size(), 0, 0} :
+      locate(line));
+
+  if (loc.piece == std::string::npos)
+  {
+    return LINE_NUMBER_UNKNOWN;
+  }
+
+  if (forward)
+  {
+    int no = line;
+
+    for (size_t i = loc.piece; i < m_pieces.size(); i++)
+    {
+      const auto&  p(m_pieces[i]);
+      const size_t begin(i == loc.piece ? loc.offset : 0);
+
+      if (const auto pos = f(view(p).substr(begin)); pos != std::string::npos)
+      {
+        return no + ends(p, begin, begin + pos);
+      }
+
+      if (i + 1 < m_pieces.size())
+      {
+        no += ends(p, begin, p.size);
+      }
+    }
+
+    return LINE_NUMBER_UNKNOWN;
+  }
+
+  for (size_t i = std::min(loc.piece + 1, m_pieces.size()); i-- > 0;)
+  {
+    const auto&  p(m_pieces[i]);
+    const size_t end(i == loc.piece ? loc.offset : p.size);
+
+    if (const auto pos = f(view(p).substr(0, end));
+        end > 0 && pos != std::string::npos)
+    {
+      // Count the line ends before the piece only for the match.
+      int no = 0;
+
+      for (size_t j = 0; j < i; j++)
+      {
+        no += lines(m_pieces[j], true);
+      }
+
+      return no + ends(p, 0, pos);
+    }
+  }
+
+  return LINE_NUMBER_UNKNOWN;
+}
+
+bool wex::ex_stream_pieces::for_each(int line, const iterate_t& f) const
+{
+  const auto loc(locate(line));
+
+  if (loc.piece == std::string::npos)
+  {
+    return false;
+  }
+
+  for (size_t i = loc.piece; i < m_pieces.size(); i++)
+  {
+    if (!f(view(m_pieces[i]).substr(i == loc.piece ? loc.offset : 0)))
+    {
+      break;
+    }
+  }
+
+  return true;
+}
+
+std::string wex::ex_stream_pieces::get(int begin, int end) const
+{
+  const auto from(locate(begin));
+
+  if (from.piece == std::string::npos || end < begin)
+  {
+    return std::string();
+  }
+
+  auto to(locate(end + 1));
+
+  if (to.piece == std::string::npos)
+  {
+    to = {m_pieces.size(), 0, 0};
+  }
+
+  std::string text;
+
+  for (size_t i = from.piece; i <= to.piece && i < m_pieces.size(); i++)
+  {
+    auto v(view(m_pieces[i]));
+
+    if (i == to.piece)
+    {
+      v = v.substr(0, to.offset);
+    }
+
+    if (i == from.piece)
+    {
+      v.remove_prefix(from.offset);
+    }
+
+    text.append(v);
+  }
+
+  return text;
+}
+
+bool wex::ex_stream_pieces::has_end(const piece& p) const
+{
+  if (p.add)
+  {
+    return p.size > 0 && m_add[p.offset + p.size - 1] == '\n';
+  }
+
+  return p.offset + p.size < m_index.data().size() ||
+         m_index.data().back() == '\n';
+}
+
+bool wex::ex_stream_pieces::insert(int line, const std::string& text)
+{
+  if (text.empty())
+  {
+    return false;
+  }
+
+  const auto i(split(line));
+
+  if (i == std::string::npos)
+  {
+    return false;
+  }
+
+  m_undo.push_back(m_pieces);
+
+  // Inserting after a last line without eol first ends that line.
+  const std::string eol(
+    i == m_pieces.size() && i > 0 && !has_end(m_pieces.back()) ? "\n" : "");
+
+  m_pieces.insert(
+    m_pieces.begin() + i,
+    {true,
+     m_add.size(),
+     eol.size() + text.size(),
+     0,
+     static_cast<int>(eol.size() + std::ranges::count(text, '\n'))});
+
+  m_add.append(eol + text);
+
+  return true;
+}
+
+size_t wex::ex_stream_pieces::line(int line, char* buffer, size_t size) const
+{
+  const auto loc(locate(line));
+
+  if (loc.piece == std::string::npos || loc.piece == m_pieces.size())
+  {
+    return std::string::npos;
+  }
+
+  const auto data(m_index.data());
+  size_t     n = 0;
+
+  for (size_t i = loc.piece; i < m_pieces.size(); i++)
+  {
+    const auto&  p(m_pieces[i]);
+    const size_t begin(i == loc.piece ? loc.offset : 0);
+    const auto   v(view(p).substr(begin));
+
+    size_t length = v.size();
+    bool   ended  = false;
+
+    if (p.add)
+    {
+      if (const auto eol = v.find('\n'); eol != std::string::npos)
+      {
+        length = eol;
+        ended  = true;
+      }
+    }
+    else
+    {
+      const auto end(std::min(
+        m_index.line_end(p.offset + begin),
+        p.offset + p.size));
+
+      length = end - p.offset - begin;
+      ended  = end < data.size() || data.back() == '\n';
+
+      if (ended && length > 0 && v[length - 1] == '\n')
+      {
+        length--;
+      }
+    }
+
+    const auto copy(std::min(length, size - 1 - n));
+    memcpy(buffer + n, v.data(), copy);
+    n += copy;
+
+    if (ended)
+    {
+      break;
+    }
+  }
+
+  buffer[n] = 0;
+
+  return n;
+}
+
+int wex::ex_stream_pieces::line_count(bool wait) const
+{
+  int count = 0;
+
+  for (const auto& p : m_pieces)
+  {
+    const auto l(lines(p, wait));
+
+    if (l == LINE_COUNT_UNKNOWN)
+    {
+      return LINE_COUNT_UNKNOWN;
+    }
+
+    count += l;
+  }
+
+  return !m_pieces.empty() && !has_end(m_pieces.back()) ? count + 1 : count;
+}
+
+int wex::ex_stream_pieces::lines(const piece& p, bool wait) const
+{
+  if (p.lines >= 0)
+  {
+    return p.lines;
+  }
+
+  const auto count(
+    wait ? m_index.line_count_request() : m_index.line_count());
+
+  if (count == LINE_COUNT_UNKNOWN)
+  {
+    return LINE_COUNT_UNKNOWN;
+  }
+
+  return count - p.line - (m_index.data().back() == '\n' ? 0 : 1);
+}
+
+wex::ex_stream_pieces::location wex::ex_stream_pieces::locate(int line) const
+{
+  if (line < 0)
+  {
+    return {std::string::npos, 0, 0};
+  }
+
+  if (line == 0)
+  {
+    return {0, 0, 0};
+  }
+
+  // line starts after its line'th line end
+  int count = 0;
+
+  for (size_t i = 0; i < m_pieces.size(); i++)
+  {
+    const auto& p(m_pieces[i]);
+    const int   k = line - count;
+    size_t      pos(std::string::npos);
+
+    if (p.add)
+    {
+      const auto v(view(p));
+
+      pos = 0;
+
+      for (int n = 0; n < k && pos != std::string::npos; n++)
+      {
+        const auto eol(v.find('\n', pos));
+        pos = eol == std::string::npos ? eol : eol + 1;
+      }
+    }
+    else if (p.lines < 0 || k <= p.lines)
+    {
+      if (const auto b = m_index.line_begin(p.line + k);
+          b != std::string::npos && b <= p.offset + p.size)
+      {
+        pos = b - p.offset;
+      }
+      else if (k == lines(p, true))
+      {
+        // The line is not in the (partial) index, so it is at or after
+        // the end of the data, only then the complete index is needed.
+        pos = p.size;
+      }
+    }
+
+    if (pos != std::string::npos)
+    {
+      return pos == p.size ? location{i + 1, 0, 0} : location{i, pos, k};
+    }
+
+    count += lines(p, true);
+  }
+
+  // The end of a last line without eol.
+  if (
+    line == count + 1 && !m_pieces.empty() && !has_end(m_pieces.back()))
+  {
+    return {m_pieces.size(), 0, 0};
+  }
+
+  return {std::string::npos, 0, 0};
+}
+
+bool wex::ex_stream_pieces::move(int begin, int end, int dest)
+{
+  if (dest >= begin && dest <= end + 1)
+  {
+    return false;
+  }
+
+  size_t first, last;
+
+  if (dest < 0 || split(dest) == std::string::npos ||
+      !split(begin, end, first, last))
+  {
+    return false;
+  }
+
+  auto to(locate(dest).piece);
+
+  m_undo.push_back(m_pieces);
+
+  // A moved last line without eol gets one, unless moved to the end.
+  if (!has_end(m_pieces[last - 1]) && to < m_pieces.size())
+  {
+    m_pieces.insert(m_pieces.begin() + last, {true, m_add.size(), 1, 0, 1});
+    m_add.push_back('\n');
+
+    if (to >= last)
+    {
+      to++;
+    }
+
+    last++;
+  }
+
+  if (to > last)
+  {
+    std::rotate(
+      m_pieces.begin() + first,
+      m_pieces.begin() + last,
+      m_pieces.begin() + to);
+  }
+  else
+  {
+    std::rotate(
+      m_pieces.begin() + to,
+      m_pieces.begin() + first,
+      m_pieces.begin() + last);
+  }
+
+  return true;
+}
+
+bool wex::ex_stream_pieces::replace(
+  int                begin,
+  int                end,
+  const std::string& text)
+{
+  size_t first, last;
+
+  if (!split(begin, end, first, last))
+  {
+    return false;
+  }
+
+  m_undo.push_back(m_pieces);
+  m_pieces.erase(m_pieces.begin() + first, m_pieces.begin() + last);
+
+  if (!text.empty())
+  {
+    m_pieces.insert(
+      m_pieces.begin() + first,
+      {true,
+       m_add.size(),
+       text.size(),
+       0,
+       static_cast<int>(std::ranges::count(text, '\n'))});
+
+    m_add.append(text);
+  }
+
+  return true;
+}
+
+size_t wex::ex_stream_pieces::split(int line)
+{
+  const auto loc(locate(line));
+
+  if (loc.piece == std::string::npos || loc.offset == 0)
+  {
+    return loc.piece;
+  }
+
+  auto& p(m_pieces[loc.piece]);
+  auto  right(p);
+
+  right.offset += loc.offset;
+  right.size -= loc.offset;
+  right.line  = p.add ? 0 : p.line + loc.lines;
+  right.lines = p.lines < 0 ? -1 : p.lines - loc.lines;
+
+  p.size  = loc.offset;
+  p.lines = loc.lines;
+
+  m_pieces.insert(m_pieces.begin() + loc.piece + 1, right);
+
+  return loc.piece + 1;
+}
+
+bool wex::ex_stream_pieces::split(
+  int     begin,
+  int     end,
+  size_t& first,
+  size_t& last)
+{
+  if (begin < 0 || end < begin)
+  {
+    return false;
+  }
+
+  first = split(begin);
+
+  if (first == std::string::npos || first == m_pieces.size())
+  {
+    return false;
+  }
+
+  last = split(end + 1);
+
+  return last != std::string::npos;
+}
+
+bool wex::ex_stream_pieces::undo()
+{
+  if (m_undo.empty())
+  {
+    return false;
+  }
+
+  m_pieces = std::move(m_undo.back());
+  m_undo.pop_back();
+
+  return true;
+}
+
+std::string_view wex::ex_stream_pieces::view(const piece& p) const
+{
+  return (p.add ? std::string_view(m_add) : m_index.data())
+    .substr(p.offset, p.size);
+}
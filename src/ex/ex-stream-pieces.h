@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ex-stream-pieces.h
+// Purpose:   Declaration of class wex::ex_stream_pieces
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace wex
+{
+class ex_stream_index;
+
+/// Offers a piece table on top of the data of an ex_stream_index.
+/// The original data is never changed, edits are line based, and
+/// inserted text is appended to an add buffer. So an edit costs
+/// the size of the edit, and not the size of the file.
+/// Each edit can be undone.
+/// A line ends at an eol, or in the original data at the end
+/// of a line as split by the index (block mode).
+class ex_stream_pieces
+{
+public:
+  /// Callback for iterating, return false to stop.
+  typedef std::function<bool(std::string_view)> iterate_t;
+
+  /// Callback for searching, returns offset of the first match
+  /// (forward) or last match (backward) in the view,
+  /// or std::string::npos.
+  typedef std::function<size_t(std::string_view)> search_t;
+
+  /// Constructor, specify the index.
+  explicit ex_stream_pieces(ex_stream_index& index);
+
+  /// Returns true if an edit can be undone.
+  bool can_undo() const { return !m_undo.empty(); }
+
+  /// Copies lines begin up to and including end, before line dest.
+  bool copy(int begin, int end, int dest);
+
+  /// Erases lines begin up to and including end.
+  bool erase(int begin, int end);
+
+  /// Finds using the callback, forward starting at begin of line,
+  /// or backward before begin of line, or backward from the end
+  /// if line is LINE_NUMBER_UNKNOWN.
+  /// Returns the line of the match, or LINE_NUMBER_UNKNOWN.
+  int find(int line, bool forward, const search_t& f) const;
+
+  /// Iterates over all data starting at begin of line.
+  /// Returns false if line is not present.
+  bool for_each(int line, const iterate_t& f) const;
+
+  /// Returns text of lines begin up to and including end,
+  /// including eols.
+  std::string get(int begin, int end) const;
+
+  /// Inserts text before line.
+  bool insert(int line, const std::string& text);
+
+  /// Copies line without eol into buffer, at most size - 1 chars,
+  /// and adds a 0.
+  /// Returns the number of chars copied, or std::string::npos if line
+  /// is not present.
+  size_t line(int line, char* buffer, size_t size) const;
+
+  /// Returns number of lines. If you do not wait,
+  /// LINE_COUNT_UNKNOWN is returned if index is not yet complete.
+  int line_count(bool wait = true) const;
+
+  /// Moves lines begin up to and including end, before line dest.
+  bool move(int begin, int end, int dest);
+
+  /// Replaces lines begin up to and including end by text.
+  bool replace(int begin, int end, const std::string& text);
+
+  /// Returns number of pieces.
+  size_t size() const { return m_pieces.size(); }
+
+  /// Undoes last edit.
+  bool undo();
+
+private:
+  struct piece
+  {
+    bool   add;    // in add buffer, otherwise in original data
+    size_t offset; // offset in add buffer or original data
+    size_t size;
+    int    line;  // for original data: index line of the offset
+    int    lines; // line ends, -1: original up to end of data (not counted)
+  };
+
+  struct location
+  {
+    size_t piece;  // index of piece, or npos if line not present
+    size_t offset; // offset in piece
+    int    lines;  // line ends in piece before offset
+  };
+
+  int      ends(const piece& p, size_t begin, size_t end) const;
+  bool     has_end(const piece& p) const;
+  int      lines(const piece& p, bool wait) const;
+  location locate(int line) const;
+  size_t   split(int line);
+  bool     split(int begin, int end, size_t& first, size_t& last);
+
+  std::string_view view(const piece& p) const;
+
+  ex_stream_index& m_index;
+
+  std::string m_add;
+
+  std::vector<piece>              m_pieces;
+  std::vector<std::vector<piece>> m_undo;
+};
+}; // namespace wex
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ex-stream-scan.cpp
+// Purpose:   Implementation of class wex::ex_stream_scan
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include "ex-stream-line.h"
+#include "ex-stream-scan.h"
+
+wex::ex_stream_scan::ex_stream_scan(ex_stream_line& sl, size_t max_line_size)
+  : m_sl(sl)
+  , m_max_line_size(std::max(max_line_size, (size_t)1))
+{
+}
+
+bool wex::ex_stream_scan::feed(std::span<const char> block)
+{
+  if (m_stop)
+  {
+    return false;
+  }
+
+  if (m_copy_rest)
+  {
+    m_sl.copy_rest(block);
+    return true;
+  }
+
+  const char*       it  = block.data();
+  const char* const end = block.data() + block.size();
+
+  while (it < end)
+  {
+    const size_t size =
+      std::min(m_max_line_size - m_line.size(), (size_t)(end - it));
+    const auto* eol  = static_cast<const char*>(memchr(it, '\n', size));
+    const auto* next = eol != nullptr ? eol + 1 : it + size;
+
+    // The line continues in the next block.
+    if (eol == nullptr && m_line.size() + size < m_max_line_size)
+    {
+      m_line.append(it, next);
+      return true;
+    }
+
+    ex_stream_line::handle_t result;
+
+    if (m_line.empty())
+    {
+      result = m_sl.handle(it, next - it);
+    }
+    else
+    {
+      m_line.append(it, next);
+      result = m_sl.handle(m_line.data(), m_line.size());
+      m_line.clear();
+    }
+
+    it = next;
+
+    switch (result)
+    {
+      case ex_stream_line::HANDLE_COPY_REST:
+        m_copy_rest = true;
+        m_sl.copy_rest(std::span{it, end});
+        return true;
+
+      case ex_stream_line::HANDLE_ERROR:
+      case ex_stream_line::HANDLE_STOP:
+        m_stop = true;
+        return false;
+
+      default:
+        break;
+    }
+  }
+
+  return true;
+}
+
+void wex::ex_stream_scan::finish()
+{
+  if (!m_stop)
+  {
+    m_sl.handle(m_line.data(), m_line.size());
+    m_line.clear();
+  }
+}
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      ex-stream-scan.h
+// Purpose:   Declaration of class wex::ex_stream_scan
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <span>
+#include <string>
+
+namespace wex
+{
+class ex_stream_line;
+
+/// Splits blocks of data into lines, and hands each line
+/// to an ex_stream_line. Lines within a block are handled without
+/// copying, only a line that continues in the next block is kept.
+/// As soon as all next lines remain unchanged, blocks are copied
+/// as a whole.
+class ex_stream_scan
+{
+public:
+  /// Constructor, specify line handler, and max size of a line.
+  ex_stream_scan(ex_stream_line& sl, size_t max_line_size);
+
+  /// Handles all lines in the block.
+  /// Returns false if no more blocks are needed.
+  bool feed(std::span<const char> block);
+
+  /// Handles the last line, if scanning was not stopped.
+  void finish();
+
+  /// Returns true if blocks are copied as a whole.
+  bool is_copy_rest() const { return m_copy_rest; }
+
+private:
+  ex_stream_line& m_sl;
+  const size_t    m_max_line_size;
+
+  bool m_copy_rest{false}, m_stop{false};
+
+  std::string m_line;
+};
+}; // namespace wex
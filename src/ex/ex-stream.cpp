@@ -2,10 +2,11 @@
 // Name:      ex-stream.cpp
 // Purpose:   Implementation of class wex::ex_stream
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2020-2025 Anton van Wezenbeek
+// Copyright: (c) 2020-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <wex/core/core.h>
+#include <wex/core/file-watcher.h>
 #include <wex/core/log.h>
 #include <wex/core/temp-filename.h>
 #include <wex/data/find.h>
@@ -16,43 +17,12 @@
 #include <wex/ui/frame.h>
 #include <wex/ui/frd.h>
 
+#include "ex-stream-index.h"
 #include "ex-stream-line.h"
+#include "ex-stream-pieces.h"
+#include "ex-stream-scan.h"
 
-#define STREAM_LINE_ON_CHAR()                                                  \
-  {                                                                            \
-    if (m_stream == nullptr || !range.is_ok())                                 \
-    {                                                                          \
-      return false;                                                            \
-    }                                                                          \
-                                                                               \
-    m_stream->clear();                                                         \
-    m_stream->seekg(0);                                                        \
-                                                                               \
-    size_t i = 0;                                                              \
-    char   c;                                                                  \
-                                                                               \
-    while (m_stream->get(c))                                                   \
-    {                                                                          \
-      m_current_line[i++] = c;                                                 \
-                                                                               \
-      if (c == '\n' || i == m_line_size_requested)                             \
-      {                                                                        \
-        if (sl.handle(m_current_line, i) == wex::ex_stream_line::HANDLE_STOP)  \
-        {                                                                      \
-          break;                                                               \
-        }                                                                      \
-      }                                                                        \
-    }                                                                          \
-                                                                               \
-    sl.handle(m_current_line, i);                                              \
-                                                                               \
-    m_stream->clear();                                                         \
-                                                                               \
-    if (sl.actions() > 0 && sl.is_write() && !copy(m_temp, m_work))            \
-    {                                                                          \
-      return false;                                                            \
-    }                                                                          \
-  }
+#include <filesystem>
 
 // boost::regex (1.85) has better performance than std::regex (llvm-17):
 /*
@@ -66,6 +36,79 @@ boost::regex:
 */
 #include <boost/regex.hpp>
 
+namespace wex
+{
+// Returns offset of first (forward) or last match of text
+// within [begin, end) of data, or std::string::npos.
+size_t find_in(
+  std::string_view    data,
+  size_t              begin,
+  size_t              end,
+  const std::string&  text,
+  const boost::regex* r,
+  bool                forward)
+{
+  if (begin >= end)
+  {
+    return std::string::npos;
+  }
+
+  if (r == nullptr)
+  {
+    const std::string_view v(data.substr(begin, end - begin));
+    const auto             pos(forward ? v.find(text) : v.rfind(text));
+    return pos == std::string::npos ? pos : begin + pos;
+  }
+
+  // For backward searching use windows starting at a line,
+  // and take the last match in the window.
+  const size_t window = forward ? end - begin : 1000000;
+  size_t       last   = end;
+
+  while (last > begin)
+  {
+    size_t first = begin;
+
+    if (last - begin > window)
+    {
+      if (const auto eol = data.rfind('\n', last - window);
+          eol != std::string::npos && eol >= begin)
+      {
+        first = eol + 1;
+      }
+    }
+
+    size_t       found = std::string::npos;
+    boost::cmatch m;
+    auto          flags = boost::match_default | boost::match_not_dot_newline;
+
+    for (const char* it = data.data() + first;
+         it < data.data() + last &&
+         boost::regex_search(it, data.data() + last, m, *r, flags);
+         it = m[0].second > m[0].first ? m[0].second : m[0].first + 1)
+    {
+      found = m[0].first - data.data();
+
+      if (forward)
+      {
+        return found;
+      }
+
+      flags |= boost::match_prev_avail;
+    }
+
+    if (found != std::string::npos || first == begin)
+    {
+      return found;
+    }
+
+    last = first;
+  }
+
+  return std::string::npos;
+}
+} // namespace wex
+
 wex::ex_stream::ex_stream(wex::ex* ex)
   : m_context_lines(40)
   , m_buffer_size(1000000)
@@ -77,27 +120,15 @@ wex::ex_stream::ex_stream(wex::ex* ex)
       m_stc,
       [this](wxTimerEvent&)
       {
-        if (m_file != nullptr && m_file->check_sync())
-        {
-          if (m_is_modified)
-          {
-            log::status("Could not sync") << "file is modified";
-            m_function_repeat.activate(false);
-          }
-          else
-          {
-            m_file->close();
-            m_file->open(std::ios_base::in);
-            m_stream->clear();
-            m_stream->seekg(0);
-          }
-        }
+        sync_changed();
       })
 {
 }
 
 wex::ex_stream::~ex_stream()
 {
+  file_watcher::unsubscribe(m_watch_id);
+
   delete[] m_buffer;
   delete[] m_current_line;
 
@@ -113,6 +144,10 @@ bool wex::ex_stream::copy(file* from, file* to)
     return false;
   }
 
+  // The mapping must be released before its file is truncated.
+  m_pieces.reset();
+  m_index.reset();
+
   to->close();
   to->open(std::ios_base::out);
 
@@ -131,14 +166,28 @@ bool wex::ex_stream::copy(file* from, file* to)
   m_stream      = &to->stream();
   m_is_modified = true;
 
+  index(to->path());
+
   return true;
 }
 
 bool wex::ex_stream::copy(const addressrange& range, const address& dest)
 {
+  if (m_pieces != nullptr)
+  {
+    const auto begin(range.begin().get_line() - 1),
+      end(range.end().get_line() - 1);
+
+    return range.is_ok() && m_pieces->copy(begin, end, dest.get_line()) &&
+           pieces_modified(std::to_string(end - begin + 1) + " added lines");
+  }
+
   ex_stream_line sl(m_temp, range, dest, ex_stream_line::ACTION_COPY);
 
-  STREAM_LINE_ON_CHAR();
+  if (!scan(range, sl))
+  {
+    return false;
+  }
 
   m_last_line_no = sl.lines() + sl.actions() - 1;
 
@@ -149,9 +198,21 @@ bool wex::ex_stream::copy(const addressrange& range, const address& dest)
 
 bool wex::ex_stream::erase(const addressrange& range)
 {
+  if (m_pieces != nullptr)
+  {
+    const auto begin(range.begin().get_line() - 1),
+      end(range.end().get_line() - 1);
+
+    return range.is_ok() && m_pieces->erase(begin, end) &&
+           pieces_modified(std::to_string(end - begin + 1) + " fewer lines");
+  }
+
   ex_stream_line sl(m_temp, ex_stream_line::ACTION_ERASE, range);
 
-  STREAM_LINE_ON_CHAR();
+  if (!scan(range, sl))
+  {
+    return false;
+  }
 
   m_last_line_no = sl.lines() - sl.actions() - 1;
 
@@ -226,6 +287,50 @@ bool wex::ex_stream::find_data(const data::find& f)
     return false;
   }
 
+  if (m_pieces != nullptr)
+  {
+    // Search the pieces, not searching in the current line.
+    const bool  start(m_line_no == LINE_COUNT_UNKNOWN);
+    const auto* re(use_regex ? &r : nullptr);
+    const auto  search = [&](std::string_view v)
+    {
+      return find_in(v, 0, v.size(), f.text(), re, f.is_forward());
+    };
+
+    auto no = f.is_forward() ?
+                m_pieces->find(start ? 0 : m_line_no + 1, true, search) :
+                m_pieces->find(
+                  start ? LINE_NUMBER_UNKNOWN : m_line_no,
+                  false,
+                  search);
+
+    if (no == LINE_NUMBER_UNKNOWN && !f.recursive())
+    {
+      f.statustext();
+
+      no = m_pieces->find(
+        f.is_forward() ? 0 : LINE_NUMBER_UNKNOWN,
+        f.is_forward(),
+        search);
+
+      if (no == LINE_NUMBER_UNKNOWN)
+      {
+        f.recursive(true);
+        f.statustext();
+        f.recursive(false);
+      }
+    }
+
+    if (no == LINE_NUMBER_UNKNOWN || !pieces_line(no))
+    {
+      return false;
+    }
+
+    log::trace("ex stream found") << f.text() << "current" << m_line_no;
+
+    return true;
+  }
+
   bool found = false;
 
   m_stream->clear();
@@ -302,6 +407,15 @@ int wex::ex_stream::get_current_line() const
 
 int wex::ex_stream::get_line_count() const
 {
+  if (m_pieces != nullptr)
+  {
+    if (const auto count(m_pieces->line_count(false));
+        count != LINE_COUNT_UNKNOWN)
+    {
+      return count;
+    }
+  }
+
   return m_last_line_no;
 }
 
@@ -312,6 +426,13 @@ int wex::ex_stream::get_line_count_request()
     return LINE_COUNT_UNKNOWN;
   }
 
+  if (m_pieces != nullptr)
+  {
+    m_last_line_no = m_pieces->line_count();
+    m_block_mode   = m_block_mode || m_index->is_block_mode();
+    return m_last_line_no;
+  }
+
   const auto pos = m_stream->tellg();
 
   m_stream->clear();
@@ -366,7 +487,10 @@ bool wex::ex_stream::get_lines(
 {
   ex_stream_line sl(m_temp, ex_stream_line::ACTION_GET, range, flags);
 
-  STREAM_LINE_ON_CHAR();
+  if (!scan(range, sl))
+  {
+    return false;
+  }
 
   m_text = sl.copy();
 
@@ -375,6 +499,20 @@ bool wex::ex_stream::get_lines(
 
 bool wex::ex_stream::get_next_line()
 {
+  if (m_pieces != nullptr)
+  {
+    const int no(m_line_no == LINE_COUNT_UNKNOWN ? 0 : m_line_no + 1);
+
+    if (!pieces_line(no))
+    {
+      m_last_line_no = no;
+      log::status("at end-of-file");
+      return false;
+    }
+
+    return true;
+  }
+
   if (!m_stream->getline(m_current_line, m_line_size_requested))
   {
     if (m_stream->eof())
@@ -404,6 +542,11 @@ bool wex::ex_stream::get_next_line()
 
 bool wex::ex_stream::get_previous_line()
 {
+  if (m_pieces != nullptr)
+  {
+    return m_line_no > 0 && pieces_line(m_line_no - 1);
+  }
+
   auto pos(m_stream->tellg());
 
   if (static_cast<int>(pos) - static_cast<int>(m_line_size_requested) > 0)
@@ -477,6 +620,12 @@ bool wex::ex_stream::get_previous_line()
 
 const std::string* wex::ex_stream::get_work() const
 {
+  if (m_pieces != nullptr)
+  {
+    m_work_text = m_pieces->get(0, m_pieces->line_count() - 1);
+    return &m_work_text;
+  }
+
   if (m_work == nullptr)
   {
     return nullptr;
@@ -499,6 +648,31 @@ void wex::ex_stream::goto_line(int no)
   log::trace("ex stream goto_line")
     << no << "current" << m_line_no << "pos" << (int)m_stream->tellg();
 
+  if (m_pieces != nullptr)
+  {
+    if (no == 0 || (no < 100 && no < m_line_no))
+    {
+      m_stc->SetReadOnly(false);
+      m_stc->ClearAll();
+      m_stc->SetReadOnly(true);
+    }
+
+    if (!pieces_line(no))
+    {
+      m_last_line_no = m_pieces->line_count();
+      log::status("at end-of-file");
+
+      if (!pieces_line(m_last_line_no - 1))
+      {
+        return;
+      }
+    }
+
+    set_text();
+
+    return;
+  }
+
   if (no == 0 || (no < 100 && no < m_line_no))
   {
     m_line_no             = LINE_COUNT_UNKNOWN;
@@ -539,6 +713,26 @@ void wex::ex_stream::goto_line(int no)
   }
 }
 
+void wex::ex_stream::index(const path& p)
+{
+  m_pieces.reset();
+  m_index = std::make_unique<ex_stream_index>(p, m_line_size_default);
+
+  if (!m_index->is_ok())
+  {
+    m_index.reset();
+    return;
+  }
+
+  m_pieces = std::make_unique<ex_stream_pieces>(*m_index);
+
+  // Keep current line, if still present.
+  if (m_index->line_begin(m_line_no) == std::string::npos)
+  {
+    m_line_no = LINE_COUNT_UNKNOWN;
+  }
+}
+
 bool wex::ex_stream::insert_text(int a, const std::string& text, loc_t loc)
 {
   if (a < 0)
@@ -551,9 +745,25 @@ bool wex::ex_stream::insert_text(int a, const std::string& text, loc_t loc)
     m_ex,
     std::to_string(line) + "," + std::to_string(line));
 
+  if (m_pieces != nullptr)
+  {
+    if (!range.is_ok() || !m_pieces->insert(line - 1, text))
+    {
+      return false;
+    }
+
+    pieces_modified(std::string());
+    goto_line(line);
+
+    return true;
+  }
+
   ex_stream_line sl(m_temp, range, text);
 
-  STREAM_LINE_ON_CHAR();
+  if (!scan(range, sl))
+  {
+    return false;
+  }
 
   goto_line(line);
 
@@ -562,9 +772,48 @@ bool wex::ex_stream::insert_text(int a, const std::string& text, loc_t loc)
 
 bool wex::ex_stream::join(const addressrange& range)
 {
+  if (m_pieces != nullptr)
+  {
+    const auto begin(range.begin().get_line() - 1),
+      end(range.end().get_line() - 1);
+
+    if (!range.is_ok())
+    {
+      return false;
+    }
+
+    if (end > begin)
+    {
+      // join: remove the eols, except for the last line
+      auto       text(m_pieces->get(begin, end));
+      const bool eol(text.ends_with('\n'));
+
+      std::erase(text, '\n');
+
+      if (eol)
+      {
+        text.push_back('\n');
+      }
+
+      if (!m_pieces->replace(begin, end, text))
+      {
+        return false;
+      }
+
+      pieces_modified(std::to_string(end - begin) + " fewer lines");
+    }
+
+    goto_line(begin);
+
+    return true;
+  }
+
   ex_stream_line sl(m_temp, ex_stream_line::ACTION_JOIN, range);
 
-  STREAM_LINE_ON_CHAR();
+  if (!scan(range, sl))
+  {
+    return false;
+  }
 
   m_last_line_no = sl.lines() - sl.actions() - 1;
 
@@ -610,15 +859,105 @@ int wex::ex_stream::marker_line(char marker) const
 
 bool wex::ex_stream::move(const addressrange& range, const address& dest)
 {
+  if (m_pieces != nullptr)
+  {
+    const auto begin(range.begin().get_line() - 1),
+      end(range.end().get_line() - 1);
+
+    return range.is_ok() && m_pieces->move(begin, end, dest.get_line()) &&
+           pieces_modified(std::to_string(end - begin + 1) + " moved lines");
+  }
+
   ex_stream_line sl(m_temp, range, dest, ex_stream_line::ACTION_MOVE);
 
-  STREAM_LINE_ON_CHAR();
+  if (!scan(range, sl))
+  {
+    return false;
+  }
 
   m_ex->frame()->show_ex_message(std::to_string(sl.actions()) + " moved lines");
 
   return true;
 }
 
+bool wex::ex_stream::pieces_line(int no)
+{
+  const auto size(m_pieces->line(no, m_current_line, m_line_size_default));
+
+  if (size == std::string::npos)
+  {
+    return false;
+  }
+
+  m_line_no           = no;
+  m_line_size_current = size;
+
+  if (m_index->is_block_mode())
+  {
+    m_block_mode = true;
+  }
+
+  return true;
+}
+
+bool wex::ex_stream::pieces_modified(const std::string& message)
+{
+  m_is_modified  = true;
+  m_last_line_no = m_pieces->line_count(false);
+
+  if (!message.empty())
+  {
+    m_ex->frame()->show_ex_message(message);
+  }
+
+  return true;
+}
+
+bool wex::ex_stream::scan(const addressrange& range, ex_stream_line& sl)
+{
+  if (m_stream == nullptr || !range.is_ok())
+  {
+    return false;
+  }
+
+  ex_stream_scan scan(sl, m_line_size_requested);
+
+  if (m_pieces != nullptr)
+  {
+    // Start scanning at the range, modifications are done by the caller.
+    const auto begin(range.begin().get_line() - 1);
+
+    sl.first_line(begin);
+
+    const bool result(m_pieces->for_each(
+      begin,
+      [&scan](std::string_view v)
+      {
+        return scan.feed(v);
+      }));
+
+    scan.finish();
+
+    return result;
+  }
+
+  m_stream->clear();
+  m_stream->seekg(0);
+
+  while (m_stream->read(m_buffer, m_buffer_size) || m_stream->gcount() > 0)
+  {
+    if (!scan.feed(std::span{m_buffer, (size_t)m_stream->gcount()}))
+    {
+      break;
+    }
+  }
+
+  m_stream->clear();
+  scan.finish();
+
+  return sl.actions() == 0 || !sl.is_write() || copy(m_temp, m_work);
+}
+
 void wex::ex_stream::set_text()
 {
   m_stc->SetReadOnly(false);
@@ -669,7 +1008,21 @@ void wex::ex_stream::stream(file& f, size_t default_line_size)
   m_current_line        = new char[m_line_size_requested];
 
   m_file = &f;
-  m_function_repeat.activate();
+
+  file_watcher::unsubscribe(m_watch_id);
+
+  if ((m_watch_id = file_watcher::subscribe(
+         [this](const path&)
+         {
+           sync_changed();
+         })) == 0 ||
+      !file_watcher::add(m_watch_id, f.path()))
+  {
+    file_watcher::unsubscribe(m_watch_id);
+    m_watch_id = 0;
+    m_function_repeat.activate();
+  }
+
   m_stream = &f.stream();
   f.use_stream();
 
@@ -679,6 +1032,9 @@ void wex::ex_stream::stream(file& f, size_t default_line_size)
   m_work = new file(path(temp_filename().name()), std::ios_base::out);
   m_work->use_stream();
 
+  m_line_no = LINE_COUNT_UNKNOWN;
+  index(f.path());
+
   goto_line(0);
 }
 
@@ -686,9 +1042,23 @@ bool wex::ex_stream::substitute(
   const addressrange&     range,
   const data::substitute& data)
 {
-  ex_stream_line sl(m_temp, range, data);
+  ex_stream_line sl(m_pieces != nullptr ? nullptr : m_temp, range, data);
+
+  if (!scan(range, sl))
+  {
+    return false;
+  }
 
-  STREAM_LINE_ON_CHAR();
+  if (
+    m_pieces != nullptr && sl.actions() > 0 &&
+    (!m_pieces->replace(
+       range.begin().get_line() - 1,
+       range.end().get_line() - 1,
+       sl.copy()) ||
+     !pieces_modified(std::string())))
+  {
+    return false;
+  }
 
   m_ex->frame()->show_ex_message(
     "Replaced: " + std::to_string(sl.actions()) +
@@ -697,11 +1067,78 @@ bool wex::ex_stream::substitute(
   return true;
 }
 
+void wex::ex_stream::sync_changed()
+{
+  if (m_file == nullptr || !m_file->check_sync())
+  {
+    return;
+  }
+
+  if (m_is_modified)
+  {
+    log::status("Could not sync") << "file is modified";
+    m_function_repeat.activate(false);
+    file_watcher::unsubscribe(m_watch_id);
+    m_watch_id = 0;
+  }
+  else
+  {
+    m_pieces.reset();
+    m_index.reset();
+    m_file->close();
+    m_file->open(std::ios_base::in);
+    m_stream->clear();
+    m_stream->seekg(0);
+    index(m_file->path());
+  }
+}
+
+bool wex::ex_stream::undo()
+{
+  if (m_pieces == nullptr || !m_pieces->undo())
+  {
+    return false;
+  }
+
+  // Without further undo the file is as when read.
+  if (
+    !m_pieces->can_undo() &&
+    m_index->get_path().string() == m_file->path().string())
+  {
+    m_is_modified = false;
+  }
+
+  m_last_line_no = m_pieces->line_count(false);
+
+  goto_line(get_current_line());
+
+  return true;
+}
+
 bool wex::ex_stream::write()
 {
   log::trace("ex stream write");
 
-  if (!m_is_modified || !copy(m_work, m_file))
+  if (!m_is_modified)
+  {
+    return false;
+  }
+
+  if (m_pieces != nullptr)
+  {
+    // Write the pieces to the temp file, and release the mapping.
+    m_temp->close();
+    m_temp->open(std::ios_base::out);
+
+    m_pieces->for_each(
+      0,
+      [this](std::string_view v)
+      {
+        return m_temp->write(v);
+      });
+  }
+
+  if (!copy(m_pieces != nullptr ? m_temp : m_work, m_file))
   {
     return false;
   }
@@ -721,13 +1158,48 @@ bool wex::ex_stream::write(
 {
   log::trace("ex stream write");
 
-  wex::file file(
-    path(filename),
-    append ? std::ios::out | std::ios_base::app : std::ios::out);
+  const auto mode(append ? std::ios::out | std::ios_base::app : std::ios::out);
+
+  // Writing into the mapped file itself, the mapping must be released,
+  // so first get the range.
+  if (std::error_code ec;
+      m_index != nullptr &&
+      std::filesystem::equivalent(
+        filename,
+        std::filesystem::path(m_index->get_path().data()),
+        ec))
+  {
+    ex_stream_line sl(nullptr, ex_stream_line::ACTION_WRITE, range);
+
+    if (!scan(range, sl))
+    {
+      return false;
+    }
+
+    const auto mapped(m_index->get_path());
+
+    m_pieces.reset();
+    m_index.reset();
 
-  ex_stream_line sl(&file, ex_stream_line::ACTION_WRITE, range);
+    {
+      wex::file file(path(filename), mode);
+      file.write(sl.copy());
+    }
+
+    // The file is loaded again, so the stream equals the file.
+    index(mapped);
+    m_is_modified = false;
+  }
+  else
+  {
+    wex::file      file(path(filename), mode);
+    ex_stream_line sl(&file, ex_stream_line::ACTION_WRITE, range);
 
-  STREAM_LINE_ON_CHAR();
+    if (!scan(range, sl))
+    {
+      return false;
+    }
+  }
 
   log::info("saved") << filename;
   log::status(_("Saved")) << filename;
@@ -739,7 +1211,10 @@ bool wex::ex_stream::yank(const addressrange& range, char name)
 {
   ex_stream_line sl(m_temp, range, name);
 
-  STREAM_LINE_ON_CHAR();
+  if (!scan(range, sl))
+  {
+    return false;
+  }
 
   m_ex->frame()->show_ex_message(std::to_string(sl.actions()) + " yanked");
 
@@ -18,6 +18,13 @@
 #include <wex/ex/macros.h>
 #include <wex/syntax/lexer-props.h>
 #include <wex/ui/frame.h>
+#include <wx/timer.h>
+
+namespace wex
+{
+// Delay after setting a register before the document is saved.
+const int registers_save_delay = 2000;
+} // namespace wex
 
 wex::macros::macros()
   : m_mode(this)
@@ -29,6 +36,8 @@ wex::macros::macros()
 {
 }
 
+wex::macros::~macros() = default;
+
 bool wex::macros::erase()
 {
   if (m_macros.erase(m_mode.get_macro()) == 0)
@@ -169,6 +178,17 @@ bool wex::macros::load_document()
     return false;
   }
 
+  if (!m_is_exit_added)
+  {
+    app::add_exit(
+      [this]
+      {
+        on_exit();
+      });
+
+    m_is_exit_added = true;
+  }
+
   for (const auto& child : m_doc.document_element().children())
   {
     if (strcmp(child.name(), "abbreviation") == 0)
@@ -241,6 +261,51 @@ bool wex::macros::load_document_init()
   return true;
 }
 
+bool wex::macros::macro_to_document(const std::string& macro)
+{
+  try
+  {
+    if (
+      const auto& node = m_doc.document_element().select_node(
+        std::string("//macro[@name='" + macro + "']").c_str());
+      node && node.node())
+    {
+      m_doc.document_element().remove_child(node.node());
+      m_is_modified = true;
+    }
+
+    if (const auto& v(find(macro)); !v.empty())
+    {
+      auto node_macro = m_doc.document_element().append_child("macro");
+      node_macro.append_attribute("name") = macro;
+
+      for (const auto& it : v)
+      {
+        node_macro.append_child("command").text().set(it);
+      }
+
+      m_is_modified = true;
+
+      return true;
+    }
+  }
+  catch (pugi::xpath_exception& e)
+  {
+    log(e) << macro;
+  }
+
+  return false;
+}
+
+void wex::macros::on_exit()
+{
+  // The timer cannot be destroyed during static destruction,
+  // after wxWidgets has shut down.
+  m_registers_timer.reset();
+
+  save_document();
+}
+
 template <typename S, typename T>
 void wex::macros::parse_node(
   const pugi::xml_node& node,
@@ -355,9 +420,19 @@ bool wex::macros::record(const std::string& text, bool new_command)
 
 bool wex::macros::save_document(bool only_if_modified)
 {
-  if (
-    !m_is_loaded || !path().file_exists() ||
-    (!m_is_modified && only_if_modified))
+  if (!m_is_loaded || !path().file_exists())
+  {
+    return false;
+  }
+
+  for (const auto& reg : m_registers_modified)
+  {
+    macro_to_document(reg);
+  }
+
+  m_registers_modified.clear();
+
+  if (!m_is_modified && only_if_modified)
   {
     return false;
   }
@@ -374,37 +449,7 @@ bool wex::macros::save_document(bool only_if_modified)
 
 bool wex::macros::save_macro(const std::string& macro)
 {
-  try
-  {
-    if (const auto& v(find(macro)); !v.empty())
-    {
-      if (
-        const auto& node = m_doc.document_element().select_node(
-          std::string("//macro[@name='" + macro + "']").c_str());
-        node && node.node())
-      {
-        m_doc.document_element().remove_child(node.node());
-      }
-
-      auto node_macro = m_doc.document_element().append_child("macro");
-      node_macro.append_attribute("name") = macro;
-
-      for (const auto& it : v)
-      {
-        node_macro.append_child("command").text().set(it);
-      }
-
-      m_is_modified = true;
-
-      return save_document();
-    }
-  }
-  catch (pugi::xpath_exception& e)
-  {
-    log(e) << macro;
-  }
-
-  return false;
+  return !find(macro).empty() && macro_to_document(macro) && save_document();
 }
 
 template <typename S, typename T>
@@ -493,23 +538,48 @@ bool wex::macros::set_register(char name, const std::string& value)
     return true;
   }
 
-  commands_t v;
+  const std::string reg(1, static_cast<char>(tolower(name)));
+  auto&             v(m_macros[reg]);
 
   // The black hole register, everything written to it is discarded.
-  if (name != '_')
+  if (name == '_')
+  {
+    v.clear();
+  }
+  else if (isupper(name) && !v.empty())
   {
-    if (isupper(name))
+    // Appends in place, the register is kept as one command.
+    if (v.size() > 1)
     {
-      v.emplace_back(get_register(tolower(name)) + value);
+      v = {std::accumulate(v.begin(), v.end(), std::string())};
     }
-    else
+
+    v.front() += value;
+  }
+  else
+  {
+    v = {value};
+  }
+
+  m_registers_modified.insert(reg);
+
+  if (wxTheApp != nullptr)
+  {
+    if (m_registers_timer == nullptr)
     {
-      v.emplace_back(value);
+      m_registers_timer = std::make_unique<wxTimer>();
+      m_registers_timer->Bind(
+        wxEVT_TIMER,
+        [=, this](wxTimerEvent& event)
+        {
+          save_document();
+        });
     }
-  }
 
-  m_macros[std::string(1, static_cast<char>(tolower(name)))] = v;
-  save_macro(std::string(1, static_cast<char>(tolower(name))));
+    // Each register restarts the delay, so a series of
+    // registers results in one save.
+    m_registers_timer->StartOnce(registers_save_delay);
+  }
 
   return true;
 }
@@ -30,6 +30,26 @@
 
 namespace wex
 {
+// Returns the length of the text of a rectangular selection,
+// each line of the selection followed by an eol, unless it is thin.
+size_t rectangle_length(factory::stc* stc)
+{
+  size_t length = 0;
+
+  for (int i = 0; i < stc->GetSelections(); i++)
+  {
+    length += stc->GetSelectionNEnd(i) - stc->GetSelectionNStart(i);
+  }
+
+  if (stc->GetSelectionMode() != wxSTC_SEL_THIN)
+  {
+    length +=
+      stc->GetSelections() * (stc->GetEOLMode() == wxSTC_EOL_CRLF ? 2 : 1);
+  }
+
+  return length;
+}
+
 void update_paneinfo(factory::stc* stc, std::stringstream& text)
 {
   if (stc->GetCurrentPos() == 0 && stc->get_line_count() != LINE_COUNT_UNKNOWN)
@@ -53,6 +73,7 @@ void update_paneinfo(factory::stc* stc, std::stringstream& text)
 
     stc->GetSelection(&start, &end);
 
+    // The selection is not copied, the info is taken from positions.
     if (const int len = end - start; len == 0)
     {
       text << line << show_pos;
@@ -61,12 +82,12 @@ void update_paneinfo(factory::stc* stc, std::stringstream& text)
     {
       if (stc->SelectionIsRectangle())
       {
-        text << line << show_pos << "," << stc->GetSelectedText().length();
+        text << line << show_pos << "," << rectangle_length(stc);
       }
       else
       {
         if (const auto number_of_lines =
-              get_number_of_lines(stc->get_selected_text());
+              stc->LineFromPosition(end) - stc->LineFromPosition(start) + 1;
             number_of_lines <= 1)
         {
           text << line << show_pos << "," << len;
@@ -5,7 +5,9 @@
 // Copyright: (c) 2021-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <string_view>
 #include <thread>
+#include <vector>
 #include <wex/core/log.h>
 #include <wex/factory/defs.h>
 #include <wex/factory/process.h>
@@ -14,6 +16,7 @@
 #include <boost/process/v1/async_system.hpp>
 
 #include "process-imp.h"
+#include "process-output.h"
 
 #define WEX_POST(ID, TEXT, DEST)                                               \
   if (DEST != nullptr)                                                         \
@@ -23,8 +26,6 @@
     wxPostEvent(DEST, event);                                                  \
   }
 
-constexpr auto max_size = std::numeric_limits<std::streamsize>::max();
-
 wex::factory::process_imp::process_imp()
   : m_io(std::make_shared<boost::asio::io_context>())
   , m_queue(std::make_shared<std::queue<std::string>>())
@@ -158,40 +159,49 @@ void wex::factory::process_imp::thread_input(const process* p)
      &out  = p->m_eh_out,
      &is   = m_is]
     {
-      std::string text, line;
-      line.reserve(600);
-      text.reserve(600);
-      char c;
-
-      while (is.get(c))
-      {
-        text.push_back(c);
-
-        if (debug)
-        {
-          line.push_back(c);
-
-          if (c == '\n')
-          {
-            WEX_POST(ID_DEBUG_STDOUT, line, dbg)
-            line.clear();
-          }
-        }
-
-        if (text.size() > 500)
+      process_output output(
+        [&out](const std::string& text)
         {
-          text += "...\n";
           WEX_POST(ID_SHELL_APPEND, text, out)
-          is.ignore(max_size, '\n');
-          text.clear();
-        }
-        else if (std::isspace(static_cast<unsigned char>(c)))
+        },
+        debug ? process_output::callback_t(
+                  [&dbg](const std::string& line)
+                  {
+                    WEX_POST(ID_DEBUG_STDOUT, line, dbg)
+                  }) :
+                nullptr);
+
+      // sgetc blocks until data is available, so the output that is not
+      // yet delivered (e.g. a prompt) is delivered from this thread
+      // if no more data arrives.
+      std::jthread flusher(
+        [&output](std::stop_token st)
         {
-          WEX_POST(ID_SHELL_APPEND, text, out)
-          text.clear();
-        }
+          output.flush_on_time(st);
+        });
+
+      std::vector<char> buffer(64 * 1024);
+      auto*             sb = is.rdbuf();
+
+      // Read all available data at once, the output delivers it
+      // as blocks.
+      while (sb->sgetc() != std::char_traits<char>::eof())
+      {
+        const auto n = sb->sgetn(
+          buffer.data(),
+          std::clamp<std::streamsize>(
+            sb->in_avail(),
+            1,
+            static_cast<std::streamsize>(buffer.size())));
+
+        output.append(std::string_view(buffer.data(), n));
       }
 
+      flusher.request_stop();
+      flusher.join();
+
+      output.flush();
+
       WEX_POST(ID_SHELL_APPEND_FINISH, "", out)
     });
 
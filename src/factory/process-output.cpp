@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      process-output.cpp
+// Purpose:   Implementation of class wex::factory::process_output
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <utility>
+
+#include "process-output.h"
+
+wex::factory::process_output::process_output(
+  callback_t                block,
+  callback_t                line,
+  size_t                    max_size,
+  std::chrono::milliseconds max_time,
+  size_t                    max_word)
+  : m_block(std::move(block))
+  , m_line(std::move(line))
+  , m_max_size(max_size)
+  , m_max_word(max_word)
+  , m_max_time(max_time)
+  , m_flushed(std::chrono::steady_clock::now())
+{
+  m_text.reserve(m_max_size + 16);
+}
+
+void wex::factory::process_output::append(std::string_view text)
+{
+  std::lock_guard lock(m_mutex);
+
+  const bool  was_empty = m_text.empty();
+  const char* spaces    = " \t\n\v\f\r";
+  size_t      start     = 0;
+
+  // Text is appended as is, unless a word is too long, then the word
+  // is truncated and the remainder of the line is skipped.
+  for (size_t pos = 0; pos < text.size();)
+  {
+    if (m_skip)
+    {
+      if (const auto eol = text.find('\n', pos); eol == std::string_view::npos)
+      {
+        start = text.size();
+        break;
+      }
+      else
+      {
+        start = pos = eol + 1;
+        m_skip      = false;
+        m_word_size = 0;
+        continue;
+      }
+    }
+
+    const auto space = text.find_first_of(spaces, pos);
+    const auto word =
+      (space == std::string_view::npos ? text.size() : space) - pos;
+
+    if (m_word_size + word > m_max_word)
+    {
+      const auto cut = pos + m_max_word - m_word_size;
+
+      append_text(text.substr(start, cut - start));
+      append_text("...\n");
+
+      start = pos = cut;
+      m_skip      = true;
+      continue;
+    }
+
+    if (space == std::string_view::npos)
+    {
+      m_word_size += word;
+      break;
+    }
+
+    m_word_size = 0;
+    pos         = space + 1;
+  }
+
+  append_text(text.substr(start));
+
+  if (
+    m_text.size() >= m_max_size ||
+    std::chrono::steady_clock::now() - m_flushed >= m_max_time)
+  {
+    deliver();
+  }
+  else if (was_empty && !m_text.empty())
+  {
+    m_cv.notify_one();
+  }
+}
+
+void wex::factory::process_output::append_line(std::string_view text)
+{
+  if (m_line == nullptr)
+  {
+    return;
+  }
+
+  for (auto eol = text.find('\n'); eol != std::string_view::npos;
+       eol      = text.find('\n'))
+  {
+    m_line_text.append(text.substr(0, eol + 1));
+    m_line(m_line_text);
+    m_line_text.clear();
+    text.remove_prefix(eol + 1);
+  }
+
+  m_line_text.append(text);
+}
+
+void wex::factory::process_output::append_text(std::string_view text)
+{
+  m_text.append(text);
+  append_line(text);
+}
+
+void wex::factory::process_output::deliver()
+{
+  m_flushed = std::chrono::steady_clock::now();
+
+  if (m_text.empty())
+  {
+    return;
+  }
+
+  m_block(m_text);
+  m_text.clear();
+  m_blocks++;
+}
+
+void wex::factory::process_output::flush()
+{
+  std::lock_guard lock(m_mutex);
+  deliver();
+}
+
+void wex::factory::process_output::flush_on_time(std::stop_token st)
+{
+  std::unique_lock lock(m_mutex);
+
+  while (!st.stop_requested())
+  {
+    // Without pending text, wait for text, otherwise wait until the
+    // pending text is due, unless it is delivered by append before.
+    if (m_text.empty())
+    {
+      m_cv.wait(
+        lock,
+        st,
+        [this]
+        {
+          return !m_text.empty();
+        });
+    }
+    else if (const auto flushed = m_flushed; !m_cv.wait_until(
+               lock,
+               st,
+               flushed + m_max_time,
+               [this, flushed]
+               {
+                 return m_flushed != flushed;
+               }))
+    {
+      if (!m_text.empty() && !st.stop_requested())
+      {
+        deliver();
+      }
+    }
+  }
+}
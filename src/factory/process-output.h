@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      process-output.h
+// Purpose:   Declaration of class wex::factory::process_output
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+namespace wex::factory
+{
+/// This class coalesces process output chunks, and delivers them
+/// as larger blocks, at most each max_time, or if max_size is reached.
+/// Lines with too long text without whitespace are truncated.
+/// Optionally complete lines are delivered as well.
+class process_output
+{
+public:
+  /// Callback type, used for blocks and for lines.
+  typedef std::function<void(const std::string&)> callback_t;
+
+  /// Constructor.
+  process_output(
+    /// callback for blocks
+    callback_t block,
+    /// callback for lines, if empty no lines are delivered
+    callback_t line = nullptr,
+    /// max size of a block
+    size_t max_size = 64 * 1024,
+    /// max time between blocks
+    std::chrono::milliseconds max_time = std::chrono::milliseconds(50),
+    /// max size of text without whitespace, the remainder of the line
+    /// is skipped
+    size_t max_word = 500);
+
+  /// Appends text, and delivers a block if max size or max time
+  /// is reached.
+  void append(std::string_view text);
+
+  /// Delivers the pending block, if any.
+  void flush();
+
+  /// Delivers the pending block each time max time is reached since
+  /// the last delivery, until stop is requested.
+  /// Invoked from another thread than append, so output that is not
+  /// followed by more output (e.g. a prompt) is delivered as well.
+  void flush_on_time(std::stop_token st);
+
+  /// Returns number of blocks delivered.
+  size_t blocks() const { return m_blocks; }
+
+private:
+  void append_text(std::string_view text);
+  void append_line(std::string_view text);
+  void deliver();
+
+  const callback_t                m_block, m_line;
+  const size_t                    m_max_size, m_max_word;
+  const std::chrono::milliseconds m_max_time;
+
+  bool   m_skip{false};
+  size_t m_blocks{0}, m_word_size{0};
+
+  std::condition_variable_any m_cv;
+  std::mutex                  m_mutex;
+
+  std::string                           m_line_text, m_text;
+  std::chrono::steady_clock::time_point m_flushed;
+};
+}; // namespace wex::factory
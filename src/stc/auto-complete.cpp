@@ -262,11 +262,14 @@ bool wex::auto_complete::show_inserts(bool show) const
 {
   if (show && !m_insert.empty() && !m_inserts.empty())
   {
-    if (const auto& comp(get_string_set(m_inserts, 0, m_insert)); !comp.empty())
+    m_completions.clear();
+
+    if (const auto count(append_string_set(m_completions, m_inserts, 0, m_insert));
+        count > 0)
     {
-      m_stc->AutoCompShow(m_insert.length() - 1, comp);
+      m_stc->AutoCompShow(m_insert.length() - 1, m_completions);
       log::debug("auto_complete::show_inserts insert")
-        << m_insert << "size" << comp.size();
+        << m_insert << "size" << count;
       return true;
     }
   }
@@ -280,12 +283,18 @@ bool wex::auto_complete::show_keywords(bool show) const
     show && !m_insert.empty() &&
     m_stc->get_lexer().keyword_starts_with(m_insert))
   {
-    if (const auto& comp(m_stc->get_lexer().keywords_string(-1, 0, m_insert));
-        !comp.empty())
+    m_completions.clear();
+
+    if (const auto count(append_string_set(
+          m_completions,
+          m_stc->get_lexer().keywords(),
+          0,
+          m_insert));
+        count > 0)
     {
-      m_stc->AutoCompShow(m_insert.length() - 1, comp);
+      m_stc->AutoCompShow(m_insert.length() - 1, m_completions);
       log::debug("auto_complete::show_keywords insert")
-        << m_insert << "size" << comp.size();
+        << m_insert << "size" << count;
       return true;
     }
   }
@@ -347,20 +347,31 @@ void wex::stc::bind_other()
     {
       event.Skip();
 
-      if (event.GetUpdated() & wxSTC_UPDATE_SELECTION)
+      // Selection updates are coalesced, the statusbar is updated
+      // once after all pending events are handled.
+      if (
+        (event.GetUpdated() & wxSTC_UPDATE_SELECTION) != 0 &&
+        !m_statusbar_pending)
       {
-        m_frame->update_statusbar(this, "PaneInfo");
+        m_statusbar_pending = true;
 
-        if (wex::config(_("stc.Auto blame statusbar")).get(false))
-        {
-          for (const auto& pane : m_frame->panes_blame_format())
+        CallAfter(
+          [this]
           {
-            if (m_frame->get_statusbar()->pane_is_shown(pane.first))
+            m_statusbar_pending = false;
+            m_frame->update_statusbar(this, "PaneInfo");
+
+            if (wex::config(_("stc.Auto blame statusbar")).get(false))
             {
-              m_frame->update_statusbar(this, pane.first);
+              for (const auto& pane : m_frame->panes_blame_format())
+              {
+                if (m_frame->get_statusbar()->pane_is_shown(pane.first))
+                {
+                  m_frame->update_statusbar(this, pane.first);
+                }
+              }
             }
-          }
-        }
+          });
       }
     });
 }
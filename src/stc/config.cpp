@@ -264,6 +264,10 @@ void wex::stc::on_init()
             {_("stc.max.Size lexer"),
              item::TEXTCTRL_INT,
              std::string("1000000")},
+            {_("stc.max.Size colourise"),
+             item::TEXTCTRL_INT,
+             std::string("500000")},
+            {_("stc.max.Lines follow"), item::TEXTCTRL_INT, std::string("0")},
             {_("Repeater"), item::TEXTCTRL_INT, std::string("1000")}}},
           {_("Folding"),
            {{_("stc.Indentation guide"), item::CHECKBOX},
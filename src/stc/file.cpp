@@ -22,29 +22,40 @@
   event->SetInt(ACTION);                                                       \
   wxQueueEvent(m_stc, event);
 
+#include <cstddef>
+#include <fstream>
+#include <mutex>
 #include <thread>
 
+#ifdef __WXMSW__
+#define SCI_METHOD __stdcall
+#else
+#define SCI_METHOD
+#endif
+
 namespace wex
 {
-#ifdef USE_THREAD
-// from wxWidgets/src/stc/scintilla/include/ILexer.h
+// from wxWidgets/src/stc/scintilla/include/ILoader.h
 class ILoader
 {
 public:
-  virtual int   Release()                       = 0;
-  virtual int   AddData(char* data, int length) = 0;
-  virtual void* ConvertToDocument()             = 0;
+  virtual int SCI_METHOD Release() = 0;
+
+  virtual int SCI_METHOD AddData(const char* data, std::ptrdiff_t length) = 0;
+
+  virtual void* SCI_METHOD ConvertToDocument() = 0;
 };
 
-class loader : public ILoader
+// Size of chunks read by the loader, the first chunk is shown at once.
+const size_t load_chunk = 65536;
+} // namespace wex
+
+// State shared by the stc file and the loading thread.
+struct wex::stc_file::load_state
 {
-public:
-  int   Release() override { return 0; };
-  int   AddData(char* data, int length) override { return 0; };
-  void* ConvertToDocument() override { return nullptr; };
+  std::mutex mutex;
+  bool       cancelled{false};
 };
-#endif
-} // namespace wex
 
 wex::stc_file::stc_file(stc* stc, const wex::path& path)
   : file(path)
@@ -52,6 +63,11 @@ wex::stc_file::stc_file(stc* stc, const wex::path& path)
 {
 }
 
+wex::stc_file::~stc_file()
+{
+  load_cancel();
+}
+
 bool wex::stc_file::do_file_load(bool synced)
 {
   file_dialog dlg(this);
@@ -64,6 +80,14 @@ bool wex::stc_file::do_file_load(bool synced)
   m_stc->use_modification_markers(false);
   m_stc->keep_event_data(synced);
 
+  if (
+    m_stc->data().event().is_synced_log() && m_stc->is_visual() &&
+    !dlg.is_hexmode() && !m_stc->get_hexmode().is_active() && follow())
+  {
+    FILE_POST(FILE_LOAD_SYNC);
+    return true;
+  }
+
   if (
     m_stc->path().stat().get_size() >
     config("stc.max.Size visual").get(1000000))
@@ -75,18 +99,12 @@ bool wex::stc_file::do_file_load(bool synced)
     dlg.is_hexmode() || m_stc->data().flags().test(data::stc::WIN_HEX) ||
     (config(_("stc.Ex mode show hex")).get(false) && !m_stc->is_visual());
 
-  const std::streampos offset =
-    m_previous_size < m_stc->path().stat().get_size() &&
-        m_stc->data().event().is_synced_log() ?
-      m_previous_size :
-      std::streampos(0);
-
-  if (offset == std::streampos(0))
-  {
-    m_stc->clear();
-  }
+  m_stc->clear();
 
   m_previous_size = m_stc->path().stat().get_size();
+  m_follow_inode  = m_stc->path().stat().get_inode();
+
+  bool async = false;
 
 #ifdef USE_THREAD
   std::thread t(
@@ -102,14 +120,18 @@ bool wex::stc_file::do_file_load(bool synced)
 
         ex_stream()->stream(*this);
       }
-      else if (const auto buffer(read(offset)); buffer != nullptr)
+      else if (
+        !hexmode && !m_stc->get_hexmode().is_active() &&
+        path().stat().get_size() > static_cast<off_t>(4 * load_chunk) &&
+        load_async(path().stat().get_size()))
+      {
+        // FILE_LOAD is posted when loading is finished.
+        async = true;
+      }
+      else if (const auto buffer(read()); buffer != nullptr)
       {
         if (!m_stc->get_hexmode().is_active() && !hexmode)
         {
-#ifdef USE_THREAD
-          loader* load =
-            reinterpret_cast<loader*>(m_stc->CreateLoader(buffer->size()));
-#endif
           m_stc->append_text(*buffer);
           m_stc->DocumentStart();
         }
@@ -128,9 +150,12 @@ bool wex::stc_file::do_file_load(bool synced)
         m_stc->SetText("READ ERROR");
       }
 
-      const int action =
-        m_stc->data().event().is_synced() ? FILE_LOAD_SYNC : FILE_LOAD;
-      FILE_POST(action);
+      if (!async)
+      {
+        const int action =
+          m_stc->data().event().is_synced() ? FILE_LOAD_SYNC : FILE_LOAD;
+        FILE_POST(action);
+      }
 #ifdef USE_THREAD
     });
   t.detach();
@@ -139,6 +164,199 @@ bool wex::stc_file::do_file_load(bool synced)
   return true;
 }
 
+bool wex::stc_file::follow()
+{
+  // A truncated or replaced (rotated) file is loaded completely,
+  // as well as a file that is still being loaded.
+  if (
+    m_load != nullptr || m_stc->path().stat().get_size() < m_previous_size ||
+    m_stc->path().stat().get_inode() != m_follow_inode)
+  {
+    return false;
+  }
+
+  std::ifstream fs(path().data(), std::ios_base::in | std::ios_base::binary);
+
+  if (!fs.is_open() || !fs.seekg(m_previous_size))
+  {
+    return false;
+  }
+
+  const bool readonly = m_stc->GetReadOnly();
+  m_stc->SetReadOnly(false);
+
+  // Only the bytes added since last time are read, in batches using
+  // the same buffer, the file might still be growing while reading.
+  while (true)
+  {
+    m_follow_buffer.resize(load_chunk);
+
+    if (fs.read(m_follow_buffer.data(), m_follow_buffer.size()).gcount() == 0)
+    {
+      break;
+    }
+
+    m_follow_buffer.resize(fs.gcount());
+    m_stc->append_text(m_follow_buffer);
+    m_previous_size += fs.gcount();
+  }
+
+  // Drop the first lines if there are more lines than the limit.
+  if (const auto max(config("stc.max.Lines follow").get(0));
+      max > 0 && m_stc->GetLineCount() > max)
+  {
+    m_stc->DeleteRange(
+      0,
+      m_stc->PositionFromLine(m_stc->GetLineCount() - max));
+  }
+
+  m_stc->SetReadOnly(readonly);
+
+  return true;
+}
+
+bool wex::stc_file::load_async(size_t size)
+{
+  auto* loader = static_cast<ILoader*>(m_stc->CreateLoader(size));
+
+  if (loader == nullptr)
+  {
+    return false;
+  }
+
+  load_cancel();
+
+  // Shows the first chunk at once, and loads the complete file
+  // on a thread into a new document, that replaces the current
+  // one when finished.
+  std::string first(load_chunk, 0);
+
+  if (std::ifstream fs(path().data(), std::ios_base::in | std::ios_base::binary);
+      fs.is_open())
+  {
+    fs.read(first.data(), first.size());
+    first.resize(fs.gcount());
+  }
+
+  m_stc->append_text(first);
+  m_stc->DocumentStart();
+
+  const bool readonly = m_stc->GetReadOnly();
+  m_stc->SetReadOnly(true);
+
+  m_load = std::make_shared<load_state>();
+
+  std::thread t(
+    [this, loader, readonly, load = m_load, p = path().data()]
+    {
+      std::ifstream fs(p, std::ios_base::in | std::ios_base::binary);
+      std::string   buffer(load_chunk, 0);
+      bool          ok = fs.is_open();
+
+      while (ok && fs.read(buffer.data(), buffer.size()).gcount() > 0)
+      {
+        // 0 is SC_STATUS_OK
+        ok = (loader->AddData(buffer.data(), fs.gcount()) == 0);
+
+        if (std::lock_guard lock(load->mutex); load->cancelled)
+        {
+          loader->Release();
+          return;
+        }
+      }
+
+      ok = ok && !fs.bad();
+
+      std::lock_guard lock(load->mutex);
+
+      if (load->cancelled)
+      {
+        loader->Release();
+        return;
+      }
+
+      m_stc->CallAfter(
+        [=, this]
+        {
+          // The stc file might be gone, then the load is cancelled.
+          if (load->cancelled)
+          {
+            loader->Release();
+          }
+          else
+          {
+            load_finish(loader, ok, readonly);
+          }
+        });
+    });
+
+  t.detach();
+
+  return true;
+}
+
+void wex::stc_file::load_cancel()
+{
+  if (m_load != nullptr)
+  {
+    {
+      std::lock_guard lock(m_load->mutex);
+      m_load->cancelled = true;
+    }
+
+    // The loading thread keeps its own reference.
+    m_load.reset();
+  }
+}
+
+void wex::stc_file::load_finish(void* loader, bool ok, bool readonly)
+{
+  auto* l = static_cast<ILoader*>(loader);
+
+  m_load.reset();
+
+  if (!ok)
+  {
+    // The document only has the first chunk, replace it by an error,
+    // and keep it read-only, so it is not saved over the file.
+    l->Release();
+    log("load") << path();
+    m_stc->SetReadOnly(false);
+    m_stc->SetText("READ ERROR");
+    m_stc->EmptyUndoBuffer();
+    m_stc->SetReadOnly(true);
+    return;
+  }
+
+  const auto line(m_stc->GetFirstVisibleLine());
+  const auto pos(m_stc->GetCurrentPos());
+  const auto lexer(m_stc->get_lexer());
+
+  // The document has a reference after SetDocPointer.
+  auto* doc = l->ConvertToDocument();
+  m_stc->SetDocPointer(doc);
+  m_stc->ReleaseDocument(doc);
+
+  // The scintilla lexer belongs to the document.
+  if (!lexer.scintilla_lexer().empty())
+  {
+    m_stc->get_lexer().set(lexer);
+  }
+
+  m_stc->SetReadOnly(readonly);
+  m_stc->GotoPos(pos);
+  m_stc->SetFirstVisibleLine(line);
+
+  // The loader read until end of file, that might have grown meanwhile.
+  m_previous_size = m_stc->GetLength();
+
+  log::trace("stc_file::load_finish") << path() << m_stc->GetLength();
+
+  const int action =
+    m_stc->data().event().is_synced() ? FILE_LOAD_SYNC : FILE_LOAD;
+  FILE_POST(action);
+}
+
 void wex::stc_file::do_file_new()
 {
   m_stc->SetName(path().string());
@@ -169,6 +387,13 @@ void wex::stc_file::do_file_new()
 
 void wex::stc_file::do_file_save(bool save_as)
 {
+  if (m_load != nullptr)
+  {
+    // Only part of the file is shown, saving would truncate it.
+    log::status("Could not save") << "file is still loading";
+    return;
+  }
+
   m_stc->SetReadOnly(true); // prevent changes during saving
 
   if (!m_stc->is_visual())
@@ -43,14 +43,10 @@ wex::stc::stc(const wex::path& p, const data::stc& data)
       this,
       [this](wxTimerEvent&)
       {
-        if (
-          is_visual() && m_file.check_sync() &&
-          // the readonly flags bit of course can differ from file actual
-          // readonly mode, therefore add this check
-          !m_data.flags().test(data::stc::WIN_READ_ONLY) &&
-          path().stat().is_readonly() != GetReadOnly())
+        // The file is not watched, or no longer watched after save as.
+        if (!m_file.is_watched())
         {
-          file_readonly_attribute_changed();
+          sync_changed();
         }
       })
 {
@@ -676,6 +672,40 @@ void wex::stc::show_whitespace(bool show)
   config(_("stc.End of line")).set(show);
 }
 
+void wex::stc::sync(bool start)
+{
+  // The file watcher is used if supported, otherwise the timer,
+  // that also takes over if the file is no longer watched.
+  if (!start)
+  {
+    m_file.watch(nullptr);
+    m_function_repeat.activate(false);
+  }
+  else
+  {
+    m_file.watch(
+      [this]
+      {
+        sync_changed();
+      });
+
+    m_function_repeat.activate();
+  }
+}
+
+void wex::stc::sync_changed()
+{
+  if (
+    is_visual() && m_file.check_sync() &&
+    // the readonly flags bit of course can differ from file actual
+    // readonly mode, therefore add this check
+    !m_data.flags().test(data::stc::WIN_READ_ONLY) &&
+    path().stat().is_readonly() != GetReadOnly())
+  {
+    file_readonly_attribute_changed();
+  }
+}
+
 void wex::stc::Undo()
 {
   syntax::stc::Undo();
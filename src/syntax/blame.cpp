@@ -19,53 +19,58 @@
 
 namespace wex
 {
-std::string
-build(const std::string& key, const std::string& field, bool first = false)
+const std::string renamed(":::");
+} // namespace wex
+
+wex::blame::blame(const pugi::xml_node& node)
+  : m_blame_format(node.attribute("blame-format").value())
+  , m_date_format(node.attribute("date-format").value())
+  , m_date_print(node.attribute("date-print").as_uint())
+  , m_name(node.attribute("name").value())
+  , m_path_original("xxxxx")
+{
+  config("blame.author").set(false);
+}
+
+std::string wex::blame::build(
+  const std::string& field,
+  bool               use,
+  bool               first,
+  int                size) const
 {
   std::string add;
 
-  if (config("blame." + key).get(true))
+  if (use)
   {
     if (!first)
     {
       add += " ";
     }
 
-    if (key == "author")
-    {
-      auto text(boost::algorithm::trim_copy(field));
-
-      if (const int shown(config(_("blame.Author size")).get(-1)); shown != -1)
-      {
-        text = text.substr(0, shown);
-      }
+    auto text(boost::algorithm::trim_copy(field));
 
-      add += text;
-    }
-    else
+    if (size != -1)
     {
-      add += boost::algorithm::trim_copy(field);
+      text = text.substr(0, size);
     }
+
+    add += text;
   }
 
   return add;
 }
 
-const std::string renamed(":::");
-} // namespace wex
-
-wex::blame::blame(const pugi::xml_node& node)
-  : m_blame_format(node.attribute("blame-format").value())
-  , m_date_format(node.attribute("date-format").value())
-  , m_date_print(node.attribute("date-print").as_uint())
-  , m_name(node.attribute("name").value())
-  , m_path_original("xxxxx")
+wex::blame::settings wex::blame::get_settings()
 {
-  config("blame.author").set(false);
+  return {
+    config("blame.id").get(true),
+    config("blame.author").get(true),
+    config("blame.date").get(true),
+    config(_("blame.Author size")).get(-1)};
 }
 
 wex::blame::margin_style_t
-wex::blame::get_style(const std::string& hash, const std::string& text) const
+wex::blame::get_style(const std::string& hash, const std::string& text)
 {
   margin_style_t style = margin_style_t::UNKNOWN;
 
@@ -74,6 +79,15 @@ wex::blame::get_style(const std::string& hash, const std::string& text) const
     return style;
   }
 
+  // While streaming, the date is decoded once for each commit.
+  if (m_settings)
+  {
+    if (const auto& it = m_styles.find(hash); it != m_styles.end())
+    {
+      return it->second;
+    }
+  }
+
   if (const auto& r(chrono(m_date_format).get_time(text)); r)
   {
     const time_t now               = time(nullptr);
@@ -112,6 +126,11 @@ wex::blame::get_style(const std::string& hash, const std::string& text) const
     }
   }
 
+  if (m_settings)
+  {
+    m_styles.emplace(hash, style);
+  }
+
   return style;
 }
 
@@ -144,7 +163,12 @@ bool wex::blame::parse(const path& p, const std::string& text)
 
   try
   {
-    if (regex r(m_blame_format); r.search(text) >= 4)
+    if (m_regex == nullptr || m_regex.use_count() > 1)
+    {
+      m_regex = std::make_shared<regex>(m_blame_format);
+    }
+
+    if (auto& r(*m_regex); r.search(text) >= 4)
     {
       if (m_name == "svn" && r.size() == 4)
       {
@@ -174,8 +198,11 @@ bool wex::blame::parse(const path& p, const std::string& text)
 // 3 -> original line text
 bool wex::blame::parse_compact(const std::string& line, const regex& r)
 {
-  m_info = build("id", r[0], true) + build("author", r[1]) +
-           build("date", r[2].substr(0, m_date_print));
+  const auto& s(m_settings ? *m_settings : get_settings());
+
+  m_info = build(r[0], s.id, true) +
+           build(r[1], s.author, false, s.author_size) +
+           build(r[2].substr(0, m_date_print), s.date);
 
   if (m_info.empty())
   {
@@ -200,8 +227,11 @@ bool wex::blame::parse_compact(const std::string& line, const regex& r)
 // 5 -> original line text
 bool wex::blame::parse_full(const std::string& line, const regex& r)
 {
-  m_info = build("id", r[0], true) + build("author", r[2]) +
-           build("date", r[3].substr(0, m_date_print));
+  const auto& s(m_settings ? *m_settings : get_settings());
+
+  m_info = build(r[0], s.id, true) +
+           build(r[2], s.author, false, s.author_size) +
+           build(r[3].substr(0, m_date_print), s.date);
 
   if (m_info.empty())
   {
@@ -224,3 +254,71 @@ bool wex::blame::parse_full(const std::string& line, const regex& r)
 
   return false;
 }
+
+size_t wex::blame::stream(std::string_view chunk, const parsed_t& f)
+{
+  size_t parsed = 0;
+
+  while (!chunk.empty())
+  {
+    const auto pos = chunk.find_first_of("\r\n");
+
+    if (pos == std::string_view::npos)
+    {
+      // The rest of the line is in a next chunk.
+      m_stream_rest.append(chunk);
+      break;
+    }
+
+    if (m_stream_rest.empty())
+    {
+      parsed += stream_line(chunk.substr(0, pos), f);
+    }
+    else
+    {
+      m_stream_rest.append(chunk.substr(0, pos));
+      parsed += stream_line(m_stream_rest, f);
+      m_stream_rest.clear();
+    }
+
+    chunk.remove_prefix(pos + 1);
+  }
+
+  return parsed;
+}
+
+void wex::blame::stream_begin(const path& p)
+{
+  m_path_original = p;
+  m_settings      = get_settings();
+  m_styles.clear();
+  m_stream_rest.clear();
+}
+
+size_t wex::blame::stream_end(const parsed_t& f)
+{
+  const auto parsed = stream_line(m_stream_rest, f);
+
+  m_stream_rest.clear();
+  m_settings.reset();
+  m_styles.clear();
+
+  return parsed;
+}
+
+size_t wex::blame::stream_line(std::string_view line, const parsed_t& f)
+{
+  if (line.empty())
+  {
+    return 0;
+  }
+
+  parse(m_path_original, std::string(line));
+
+  if (f != nullptr)
+  {
+    f(*this);
+  }
+
+  return 1;
+}
@@ -263,11 +263,8 @@ bool wex::lexer::apply() const
     for_each_style(m_styles, m_stc);
   }
 
-  // And finally colour the entire document.
-  if (const auto length = m_stc->GetLength(); length > 0)
-  {
-    m_stc->Colourise(0, length - 1);
-  }
+  // And finally colour the document.
+  colourise_begin();
 
   switch (m_edge_columns.size())
   {
@@ -388,6 +385,92 @@ void wex::lexer::clear()
   }
 }
 
+bool wex::lexer::colourise(std::chrono::milliseconds budget) const
+{
+  if (!m_colourise_pending || m_stc == nullptr)
+  {
+    return false;
+  }
+
+  const auto start  = std::chrono::steady_clock::now();
+  const auto length = m_stc->GetLength();
+  const int  slice  = 65536;
+
+  while (m_stc->GetEndStyled() < length)
+  {
+    const auto end_styled = m_stc->GetEndStyled();
+
+    m_stc->Colourise(end_styled, std::min(end_styled + slice, length));
+
+    // Stop if colouring does not proceed.
+    if (m_stc->GetEndStyled() <= end_styled)
+    {
+      break;
+    }
+
+    if (std::chrono::steady_clock::now() - start >= budget)
+    {
+      return true;
+    }
+  }
+
+  m_colourise_pending = false;
+
+  log::trace("lexer::colourise all")
+    << length << "ms"
+    << std::chrono::duration_cast<std::chrono::milliseconds>(
+         std::chrono::steady_clock::now() - m_colourise_start)
+         .count();
+
+  return false;
+}
+
+void wex::lexer::colourise_begin() const
+{
+  m_colourise_pending = false;
+
+  const auto length = m_stc->GetLength();
+
+  if (length <= 0)
+  {
+    return;
+  }
+
+  m_colourise_start = std::chrono::steady_clock::now();
+
+  // A small document is coloured at once, a large one only up to
+  // the visible part with a margin, the rest is done by colourise.
+  if (length <= config(_("stc.max.Size colourise")).get(500000))
+  {
+    m_stc->Colourise(0, length - 1);
+    return;
+  }
+
+  const auto line = m_stc->DocLineFromVisible(m_stc->GetFirstVisibleLine()) +
+                    2 * m_stc->LinesOnScreen();
+  const auto end =
+    line < m_stc->GetLineCount() ? m_stc->PositionFromLine(line) : length;
+
+  m_stc->Colourise(0, end);
+  m_colourise_pending = (end < length);
+
+  log::trace("lexer::colourise visible")
+    << end << "of" << length << "ms"
+    << std::chrono::duration_cast<std::chrono::milliseconds>(
+         std::chrono::steady_clock::now() - m_colourise_start)
+         .count();
+}
+
+double wex::lexer::colourised() const
+{
+  if (m_stc == nullptr || m_stc->GetLength() == 0)
+  {
+    return 1;
+  }
+
+  return static_cast<double>(m_stc->GetEndStyled()) / m_stc->GetLength();
+}
+
 const std::string wex::lexer::comment_complete(const std::string& comment) const
 {
   if (m_command_end.empty())
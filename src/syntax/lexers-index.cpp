@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      lexers-index.cpp
+// Purpose:   Implementation of class wex::lexers_index
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/tokenizer.hpp>
+#include <wex/core/log.h>
+#include <wex/syntax/lexer.h>
+
+#include "lexers-index.h"
+
+#include <algorithm>
+
+void wex::lexers_index::add(
+  std::unordered_map<std::string, size_t>& m,
+  const std::string&                       key,
+  size_t                                   no)
+{
+  // Keep the first lexer.
+  m.try_emplace(key, no);
+}
+
+void wex::lexers_index::build(
+  const std::vector<lexer>&                               lexers,
+  const std::vector<std::pair<std::string, std::string>>& texts)
+{
+  clear();
+
+  for (size_t no = 0; no < lexers.size(); no++)
+  {
+    if (lexers[no].extensions() == "*")
+    {
+      m_globs.emplace_back(no, path_matcher("*"));
+      continue;
+    }
+
+    for (const auto& it : boost::tokenizer<boost::char_separator<char>>(
+           lexers[no].extensions(),
+           boost::char_separator<char>(";")))
+    {
+      const auto wildcard(it.find_first_of("*?"));
+
+      if (wildcard == std::string::npos)
+      {
+        add(m_names, it, no);
+      }
+      else if (
+        it.size() > 2 && it.starts_with("*.") &&
+        it.find_first_of("*?", 1) == std::string::npos)
+      {
+        add(m_extensions, it.substr(1), no);
+      }
+      else
+      {
+        m_globs.emplace_back(no, path_matcher(it));
+      }
+    }
+  }
+
+  for (const auto& t : texts)
+  {
+    try
+    {
+      m_texts.emplace_back(t.first, boost::regex(t.second));
+    }
+    catch (boost::regex_error& e)
+    {
+      log(e) << "lexers_index" << t.second;
+    }
+  }
+
+  m_size = lexers.size();
+}
+
+void wex::lexers_index::clear()
+{
+  m_extensions.clear();
+  m_globs.clear();
+  m_names.clear();
+  m_texts.clear();
+  m_size = 0;
+}
+
+std::optional<size_t>
+wex::lexers_index::find_by_filename(const std::string& filename) const
+{
+  std::optional<size_t> result;
+
+  const auto better = [&result](size_t no)
+  {
+    if (!result || no < *result)
+    {
+      result = no;
+    }
+  };
+
+  if (const auto& it = m_names.find(filename); it != m_names.end())
+  {
+    better(it->second);
+  }
+
+  for (auto pos = filename.find('.'); pos != std::string::npos;
+       pos      = filename.find('.', pos + 1))
+  {
+    if (const auto& it = m_extensions.find(filename.substr(pos));
+        it != m_extensions.end())
+    {
+      better(it->second);
+    }
+  }
+
+  // Globs are in lexers order, so stop as soon as the glob lexer
+  // is after the lexer already found.
+  for (const auto& [no, matcher] : m_globs)
+  {
+    if (result && no >= *result)
+    {
+      break;
+    }
+
+    if (matcher.matches(filename))
+    {
+      better(no);
+      break;
+    }
+  }
+
+  return result;
+}
+
+std::optional<std::string>
+wex::lexers_index::find_by_text(const std::string& text) const
+{
+  static const boost::regex trailing("[ \t\n\v\f\r]+$");
+
+  const auto& filtered(boost::regex_replace(
+    text,
+    trailing,
+    "",
+    boost::regex_constants::format_sed));
+
+  for (const auto& [name, r] : m_texts)
+  {
+    if (boost::regex_search(filtered, r))
+    {
+      return name;
+    }
+  }
+
+  return std::nullopt;
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      lexers-index.h
+// Purpose:   Declaration of class wex::lexers_index
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <boost/regex.hpp>
+#include <wex/core/path-matcher.h>
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace wex
+{
+class lexer;
+
+/// Offers an index to find lexers by filename or by text,
+/// built once after the lexers are loaded.
+/// The first lexer (in lexers order) that matches is found, as
+/// when trying all lexers in order.
+class lexers_index
+{
+public:
+  /// Builds the index.
+  void build(
+    /// the lexers
+    const std::vector<lexer>& lexers,
+    /// the texts, lexer name and regular expression
+    const std::vector<std::pair<std::string, std::string>>& texts);
+
+  /// Clears the index.
+  void clear();
+
+  /// Returns position of first lexer matching the filename, if any.
+  std::optional<size_t> find_by_filename(const std::string& filename) const;
+
+  /// Returns name of first lexer matching the text, if any.
+  std::optional<std::string> find_by_text(const std::string& text) const;
+
+  /// Returns number of lexers indexed.
+  size_t size() const { return m_size; }
+
+private:
+  void add(
+    std::unordered_map<std::string, size_t>& m,
+    const std::string&                       key,
+    size_t                                   no);
+
+  size_t m_size{0};
+
+  // *.ext fields, keyed by .ext
+  std::unordered_map<std::string, size_t> m_extensions;
+  // fields without wildcards, keyed by name
+  std::unordered_map<std::string, size_t> m_names;
+  // other fields, in lexers order
+  std::vector<std::pair<size_t, path_matcher>> m_globs;
+
+  std::vector<std::pair<std::string, boost::regex>> m_texts;
+};
+}; // namespace wex
@@ -15,6 +15,8 @@
 #include <wex/syntax/lexers.h>
 #include <wex/syntax/util.h>
 
+#include "lexers-index.h"
+
 #include <algorithm>
 #include <charconv>
 #include <functional>
@@ -28,7 +30,8 @@
    }}
 
 wex::lexers::lexers()
-  : m_path(wex::path(config::dir(), "wex-lexers.xml"))
+  : m_index(std::make_unique<lexers_index>())
+  , m_path(wex::path(config::dir(), "wex-lexers.xml"))
   , m_path_macro(wex::path(config::dir(), "wex-lexers-macro.xml"))
   , m_reflect(
       {REFLECT_ADD("default colours", m_default_colours.size()),
@@ -54,6 +57,8 @@ wex::lexers::lexers()
 {
 }
 
+wex::lexers::~lexers() = default;
+
 void wex::lexers::add_required_containers()
 {
   m_indicators.insert(indicator());
@@ -184,30 +189,43 @@ const std::string wex::lexers::apply_macro(
 void wex::lexers::apply_margin_text_style(factory::stc* stc, const blame* blame)
   const
 {
-  if (blame->line_no() < 0)
+  apply_margin_text_style(
+    stc,
+    blame->line_no(),
+    blame->style(),
+    blame->skip_info() ? std::string() : blame->info());
+}
+
+void wex::lexers::apply_margin_text_style(
+  factory::stc*         stc,
+  int                   line,
+  blame::margin_style_t style,
+  const std::string&    text) const
+{
+  if (line < 0)
   {
-    log("apply_margin_text_style") << "invalid line:" << blame->line_no();
+    log("apply_margin_text_style") << "invalid line:" << line;
     return;
   }
 
-  if (blame->style() != blame::margin_style_t::UNKNOWN)
+  if (style != blame::margin_style_t::UNKNOWN)
   {
-    const std::unordered_map<blame::margin_style_t, std::string> styles{
-      {blame::margin_style_t::NOT_COMMITTED, "style_textmargin_not_committed"},
-      {blame::margin_style_t::DAY, "style_textmargin_day"},
-      {blame::margin_style_t::MONTH, "style_textmargin_month"},
-      {blame::margin_style_t::OTHER, "style_textmargin"},
-      {blame::margin_style_t::WEEK, "style_textmargin_week"},
-      {blame::margin_style_t::YEAR, "style_textmargin_year"}};
+    static const std::unordered_map<blame::margin_style_t, std::string>
+      styles{
+        {blame::margin_style_t::NOT_COMMITTED,
+         "style_textmargin_not_committed"},
+        {blame::margin_style_t::DAY, "style_textmargin_day"},
+        {blame::margin_style_t::MONTH, "style_textmargin_month"},
+        {blame::margin_style_t::OTHER, "style_textmargin"},
+        {blame::margin_style_t::WEEK, "style_textmargin_week"},
+        {blame::margin_style_t::YEAR, "style_textmargin_year"}};
 
-    stc->MarginSetStyle(
-      blame->line_no(),
-      m_style_no_text.at(styles.at(blame->style())));
+    stc->MarginSetStyle(line, m_style_no_text.at(styles.at(style)));
   }
 
-  if (!blame->info().empty() && !blame->skip_info())
+  if (!text.empty())
   {
-    stc->MarginSetText(blame->line_no(), blame->info());
+    stc->MarginSetText(line, text);
   }
 }
 
@@ -239,6 +257,12 @@ wex::lexers::find_by_filename(const std::string& filename) const
 {
   assert(!m_lexers.empty());
 
+  if (m_index->size() == m_lexers.size())
+  {
+    const auto& no(m_index->find_by_filename(filename));
+    return no ? m_lexers[*no] : m_lexers.front();
+  }
+
   const auto& it = std::ranges::find_if(
     m_lexers,
     [filename](auto const& e)
@@ -261,18 +285,9 @@ const wex::lexer& wex::lexers::find_by_text(const std::string& text) const
 
   try
   {
-    const auto& filtered(boost::regex_replace(
-      text,
-      boost::regex("[ \t\n\v\f\r]+$"),
-      "",
-      boost::regex_constants::format_sed));
-
-    for (const auto& t : m_texts)
+    if (const auto& name(m_index->find_by_text(text)); name)
     {
-      if (boost::regex_search(filtered, boost::regex(t.second)))
-      {
-        return find(t.first);
-      }
+      return find(*name);
     }
   }
   catch (std::exception& e)
@@ -367,6 +382,8 @@ bool wex::lexers::load_document()
     }
   }
 
+  m_index->build(m_lexers, m_texts);
+
   load_document_check();
 
   m_is_loaded = true;
@@ -434,6 +451,7 @@ bool wex::lexers::load_document_init()
     m_styles.clear();
     m_styles_hex.clear();
     m_texts.clear();
+    m_index->clear();
     m_theme_colours.clear();
     m_theme_macros.clear();
 
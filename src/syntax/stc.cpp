@@ -15,6 +15,17 @@ wex::syntax::stc::stc(const data::window& data)
   : factory::stc(data)
   , m_lexer(this)
 {
+  Bind(
+    wxEVT_IDLE,
+    [=, this](wxIdleEvent& event)
+    {
+      if (m_lexer.colourise())
+      {
+        event.RequestMore();
+      }
+
+      event.Skip();
+    });
 }
 
 void wex::syntax::stc::fold(bool all)
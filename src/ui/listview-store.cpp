@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      listview-store.cpp
+// Purpose:   Implementation of class wex::listview_store
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/ui/listview-store.h>
+
+#include <charconv>
+#include <limits>
+#include <string_view>
+
+namespace wex
+{
+// The number used for an empty text in a column kept as numbers.
+constexpr long long no_number = std::numeric_limits<long long>::min();
+
+// Returns the number for the text, if the text is that number as string.
+std::optional<long long> to_number(const std::string& text)
+{
+  if (text.empty())
+  {
+    return no_number;
+  }
+
+  long long v = 0;
+
+  if (const auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), v);
+      ec != std::errc() || v == no_number || std::to_string(v) != text)
+  {
+    return std::nullopt;
+  }
+
+  return v;
+}
+
+template <typename T>
+void reorder_vector(std::vector<T>& v, const std::vector<long>& order)
+{
+  std::vector<T> sorted;
+  sorted.reserve(v.size());
+
+  for (const auto i : order)
+  {
+    sorted.emplace_back(v[i]);
+  }
+
+  v.swap(sorted);
+}
+} // namespace wex
+
+const wex::listview_store::cell
+wex::listview_store::add(const column_t& c, size_t row, const std::string& text)
+{
+  // Reuse the cell of the row above if it has the same text,
+  // e.g. the file of a next match.
+  if (row > 0 && row <= c.cells.size())
+  {
+    if (const auto& above(c.cells[row - 1]);
+        above.size == text.size() &&
+        m_arena.compare(above.offset, above.size, text) == 0)
+    {
+      return above;
+    }
+  }
+
+  const cell result{m_arena.size(), static_cast<uint32_t>(text.size())};
+  m_arena.append(text);
+
+  return result;
+}
+
+void wex::listview_store::append_column(column::type_t type)
+{
+  column_t c{type, type == column::INT, {}, {}};
+
+  if (c.is_numbers)
+  {
+    c.numbers.resize(m_size, no_number);
+  }
+  else
+  {
+    c.cells.resize(m_size, {0, 0});
+  }
+
+  m_columns.emplace_back(c);
+}
+
+void wex::listview_store::clear()
+{
+  for (auto& c : m_columns)
+  {
+    c.is_numbers = (c.type == column::INT);
+    c.cells.clear();
+    c.numbers.clear();
+  }
+
+  m_arena.clear();
+  m_size = 0;
+}
+
+void wex::listview_store::erase(size_t row)
+{
+  if (row >= m_size)
+  {
+    return;
+  }
+
+  for (auto& c : m_columns)
+  {
+    if (c.is_numbers)
+    {
+      c.numbers.erase(c.numbers.begin() + row);
+    }
+    else
+    {
+      c.cells.erase(c.cells.begin() + row);
+    }
+  }
+
+  m_size--;
+}
+
+const std::string wex::listview_store::get(size_t row, size_t col) const
+{
+  if (row >= m_size || col >= m_columns.size())
+  {
+    return std::string();
+  }
+
+  if (const auto& c(m_columns[col]); c.is_numbers)
+  {
+    return c.numbers[row] == no_number ? std::string() :
+                                         std::to_string(c.numbers[row]);
+  }
+  else
+  {
+    return m_arena.substr(c.cells[row].offset, c.cells[row].size);
+  }
+}
+
+std::optional<long long>
+wex::listview_store::get_number(size_t row, size_t col) const
+{
+  if (
+    row >= m_size || col >= m_columns.size() || !m_columns[col].is_numbers ||
+    m_columns[col].numbers[row] == no_number)
+  {
+    return std::nullopt;
+  }
+
+  return m_columns[col].numbers[row];
+}
+
+bool wex::listview_store::insert(
+  const std::vector<std::string>& row,
+  long                            index)
+{
+  if (row.size() > m_columns.size())
+  {
+    return false;
+  }
+
+  const size_t pos =
+    (index < 0 || static_cast<size_t>(index) > m_size ? m_size : index);
+
+  for (size_t no = 0; auto& c : m_columns)
+  {
+    const auto& text(no < row.size() ? row[no] : std::string());
+    no++;
+
+    if (c.is_numbers)
+    {
+      if (const auto& v(to_number(text)); v)
+      {
+        c.numbers.insert(c.numbers.begin() + pos, *v);
+        continue;
+      }
+
+      to_cells(c);
+    }
+
+    c.cells.insert(c.cells.begin() + pos, add(c, pos, text));
+  }
+
+  m_size++;
+
+  return true;
+}
+
+bool wex::listview_store::is_equal(
+  size_t             row,
+  size_t             col,
+  const std::string& text) const
+{
+  if (row >= m_size || col >= m_columns.size())
+  {
+    return false;
+  }
+
+  if (const auto& c(m_columns[col]); c.is_numbers)
+  {
+    return c.numbers[row] == no_number ? text.empty() :
+                                         std::to_string(c.numbers[row]) == text;
+  }
+  else
+  {
+    return std::string_view(m_arena).substr(
+             c.cells[row].offset,
+             c.cells[row].size) == text;
+  }
+}
+
+void wex::listview_store::reorder(const std::vector<long>& order)
+{
+  if (order.size() != m_size)
+  {
+    return;
+  }
+
+  for (auto& c : m_columns)
+  {
+    if (c.is_numbers)
+    {
+      reorder_vector(c.numbers, order);
+    }
+    else
+    {
+      reorder_vector(c.cells, order);
+    }
+  }
+}
+
+void wex::listview_store::set(size_t row, size_t col, const std::string& text)
+{
+  if (row >= m_size || col >= m_columns.size())
+  {
+    return;
+  }
+
+  auto& c(m_columns[col]);
+
+  if (c.is_numbers)
+  {
+    if (const auto& v(to_number(text)); v)
+    {
+      c.numbers[row] = *v;
+      return;
+    }
+
+    to_cells(c);
+  }
+
+  c.cells[row] = add(c, row, text);
+}
+
+void wex::listview_store::to_cells(column_t& c)
+{
+  // A text that is not a number as string, from now on
+  // the column keeps texts.
+  c.cells.reserve(c.numbers.size());
+
+  for (const auto v : c.numbers)
+  {
+    c.cells.emplace_back(add(
+      c,
+      c.cells.size(),
+      v == no_number ? std::string() : std::to_string(v)));
+  }
+
+  c.numbers.clear();
+  c.numbers.shrink_to_fit();
+  c.is_numbers = false;
+}
@@ -9,6 +9,7 @@
 #include <boost/tokenizer.hpp>
 #include <wex/core/chrono.h>
 #include <wex/core/config.h>
+#include <wex/core/file-watcher.h>
 #include <wex/core/interruptible.h>
 #include <wex/core/log.h>
 #include <wex/core/regex.h>
@@ -36,6 +37,9 @@
 
 #include <algorithm>
 #include <cctype>
+#include <numeric>
+#include <ranges>
+#include <variant>
 
 namespace wex
 {
@@ -85,6 +89,25 @@ template <typename T> int compare(T x, T y)
   return 0;
 }
 
+// Matches from find threads are kept in a ring of this size,
+// and inserted in batches of this size.
+const size_t match_ring_size = 16384, match_batch_size = 4096;
+
+// Returns the window data, using a virtual list for owner data.
+const data::window window_data(const data::listview& data)
+{
+  if (!data.owner_data())
+  {
+    return data.window();
+  }
+
+  const auto style(
+    data.window().style() == data::NUMBER_NOT_SET ? wxLC_REPORT :
+                                                    data.window().style());
+
+  return data::window(data.window()).style(style | wxLC_VIRTUAL);
+}
+
 const std::vector<item> config_items()
 {
   return std::vector<item>(
@@ -121,7 +144,7 @@ const std::vector<item> config_items()
 }; // namespace wex
 
 wex::listview::listview(const data::listview& data)
-  : factory::listview(data.window(), data.control())
+  : factory::listview(window_data(data), data.control())
   , m_col_event_id(1000)
   , m_data(
       data::listview(data)
@@ -148,10 +171,29 @@ wex::listview::listview(const data::listview& data)
 
   m_frame->update_statusbar(this);
 
+  if (m_data.type() == data::listview::FIND)
+  {
+    // The ring posts a match event without data if matches are available.
+    m_matches = std::make_shared<match_ring>(
+      match_ring_size,
+      [this]
+      {
+        wxPostEvent(this, wxCommandEvent(wxEVT_MENU, ID_LIST_MATCH));
+      });
+
+    match_ring::set(this, m_matches);
+  }
+
   if (
     m_data.type() != data::listview::NONE &&
-    m_data.type() != data::listview::TSV)
+    m_data.type() != data::listview::TSV && !m_data.owner_data())
   {
+    m_watch_id = file_watcher::subscribe(
+      [this](const path& p)
+      {
+        process_changed(p);
+      });
+
     Bind(
       wxEVT_IDLE,
       [=, this](wxIdleEvent& event)
@@ -231,6 +273,16 @@ wex::listview::listview(const data::listview& data)
   bind_other();
 }
 
+wex::listview::~listview()
+{
+  file_watcher::unsubscribe(m_watch_id);
+
+  if (m_matches != nullptr)
+  {
+    match_ring::set(this, nullptr);
+  }
+}
+
 bool wex::listview::append_columns(const std::vector<column>& cols)
 {
   SetSingleStyle(wxLC_REPORT);
@@ -249,6 +301,7 @@ bool wex::listview::append_columns(const std::vector<column>& cols)
 
     mycol.SetColumn(GetColumnCount() - 1);
     m_columns.emplace_back(mycol);
+    m_store.append_column(mycol.type());
 
     Bind(
       wxEVT_MENU,
@@ -259,6 +312,16 @@ bool wex::listview::append_columns(const std::vector<column>& cols)
       m_col_event_id + GetColumnCount() - 1);
   }
 
+  auto& c(m_match_columns);
+  c.file_name = find_column(_("File Name"));
+  c.in_folder = find_column(_("In Folder"));
+  c.type      = find_column(_("Type"));
+  c.modified  = find_column(_("Modified"));
+  c.size      = find_column(_("Size"));
+  c.line_no   = find_column(_("Line No"));
+  c.line      = find_column(_("Line"));
+  c.match     = find_column(_("Match"));
+
   return true;
 }
 
@@ -465,7 +528,19 @@ void wex::listview::clear()
     return;
   }
 
-  DeleteAllItems();
+  file_watcher::clear(m_watch_id);
+  m_item_number = 0;
+  m_watch_count = 0;
+
+  if (m_data.owner_data())
+  {
+    m_store.clear();
+    SetItemCount(0);
+  }
+  else
+  {
+    DeleteAllItems();
+  }
 
   sort_column_reset();
 
@@ -538,11 +613,36 @@ void wex::listview::edit_delete()
 
   long old_item = -1;
 
-  for (long i = -1; (i = GetNextSelected(i)) != -1;)
+  if (m_data.owner_data())
+  {
+    // Erase from the end, so the selected rows keep their index.
+    std::vector<long> rows;
+
+    for (auto i = GetFirstSelected(); i != -1; i = GetNextSelected(i))
+    {
+      rows.emplace_back(i);
+    }
+
+    for (const auto& row : std::views::reverse(rows))
+    {
+      m_store.erase(row);
+    }
+
+    old_item = rows.front();
+    SetItemCount(m_store.size());
+    Refresh();
+  }
+  else
   {
-    DeleteItem(i);
-    old_item = i;
-    i        = -1;
+    for (long i = -1; (i = GetNextSelected(i)) != -1;)
+    {
+      DeleteItem(i);
+      old_item = i;
+      i        = -1;
+    }
+
+    // The deleted paths are no longer watched after the next pass.
+    m_watch_count = -1;
   }
 
   if (old_item != -1 && old_item < GetItemCount())
@@ -587,7 +687,7 @@ bool wex::listview::find_next(const std::string& text, bool forward)
   {
     for (int col = 0; col < GetColumnCount() && match == -1; col++)
     {
-      if (find_replace_data::get()->match(GetItemText(index, col), find))
+      if (find_replace_data::get()->match(item_text(index, col), find))
       {
         match = index;
       }
@@ -665,11 +765,11 @@ const std::string wex::listview::get_item_text(
 
   if (col_name.empty())
   {
-    return GetItemText(item_number);
+    return item_text(item_number, 0);
   }
 
   const int col = find_column(col_name);
-  return col < 0 ? std::string() : GetItemText(item_number, col).ToStdString();
+  return col < 0 ? std::string() : item_text(item_number, col);
 }
 
 bool wex::listview::insert_item(
@@ -718,29 +818,35 @@ bool wex::listview::insert_item(
             break;
         }
 
-        if (no == 0)
+        // For owner data, the item is inserted in the store
+        // after validating all columns.
+        if (!m_data.owner_data())
         {
-          if (
-            (index = InsertItem(
-               requested_index == -1 ? GetItemCount() : requested_index,
-               col)) == -1)
-          {
-            log("listview InsertItem") << "index:" << index << "col:" << col;
-            return false;
-          }
-          if (
-            regex v(",fore:(.*)");
-            v.match(lexers::get()->get_default_style().value()) > 0)
+          if (no == 0)
           {
-            SetItemTextColour(index, wxColour(v[0]));
+            if (
+              (index = InsertItem(
+                 requested_index == -1 ? GetItemCount() : requested_index,
+                 col)) == -1)
+            {
+              log("listview InsertItem")
+                << "index:" << index << "col:" << col;
+              return false;
+            }
+            if (
+              regex v(",fore:(.*)");
+              v.match(lexers::get()->get_default_style().value()) > 0)
+            {
+              SetItemTextColour(index, wxColour(v[0]));
+            }
           }
-        }
-        else
-        {
-          if (!set_item(index, no, col))
+          else
           {
-            log("listview set_item") << "index:" << index << "col:" << col;
-            return false;
+            if (!set_item(index, no, col))
+            {
+              log("listview set_item") << "index:" << index << "col:" << col;
+              return false;
+            }
           }
         }
       }
@@ -754,9 +860,83 @@ bool wex::listview::insert_item(
     }
   }
 
+  if (m_data.owner_data())
+  {
+    m_store.insert(item, requested_index);
+    SetItemCount(m_store.size());
+  }
+
   return true;
 }
 
+void wex::listview::insert_match(const path_match& m)
+{
+  const auto& match(
+    m.tool().id() == ID_TOOL_REPORT_FIND ?
+      find_replace_data::get()->get_find_string() :
+      find_replace_data::get()->get_replace_string());
+
+  if (m_data.owner_data())
+  {
+    // Appends a row to the store, the file columns are taken
+    // from the previous row if it is the same file.
+    const auto& c(m_match_columns);
+    const auto& p(m.path());
+    const auto  folder(p.parent_path());
+
+    std::vector<std::string> row(m_columns.size());
+
+    const auto set = [&row](int no, std::string text)
+    {
+      if (no != -1)
+      {
+        row[no] = std::move(text);
+      }
+    };
+
+    // The item count is not yet updated, so use the store.
+    if (const auto last = m_store.size() - 1;
+        m_store.size() > 0 && c.in_folder != -1 && c.file_name != -1 &&
+        !folder.empty() && m_store.is_equal(last, c.in_folder, folder) &&
+        m_store.is_equal(last, c.file_name, p.filename()))
+    {
+      for (const auto no :
+           {c.file_name, c.in_folder, c.type, c.modified, c.size})
+      {
+        set(no, no != -1 ? m_store.get(last, no) : std::string());
+      }
+    }
+    else
+    {
+      set(c.file_name, p.file_exists() ? p.filename() : p.string());
+
+      if (p.stat().is_ok())
+      {
+        set(c.type, p.extension());
+        set(c.in_folder, folder);
+        set(c.modified, p.stat().get_modification_time_str());
+        set(c.size, std::to_string(p.stat().get_size()));
+      }
+    }
+
+    set(c.line_no, std::to_string(m.line_no() + 1));
+    set(c.line, m.context());
+    set(c.match, match);
+
+    // The caller updates the item count.
+    m_store.insert(row);
+  }
+  else
+  {
+    listitem item(this, m.path());
+
+    item.insert();
+    item.set_item(_("Line No"), std::to_string(m.line_no() + 1));
+    item.set_item(_("Line"), m.context());
+    item.set_item(_("Match"), match);
+  }
+}
+
 void wex::listview::item_activated(long item_number)
 {
   assert(item_number >= 0);
@@ -825,9 +1005,19 @@ void wex::listview::item_activated(long item_number)
 
         if (m_frame->stc_entry_dialog_show(true) == wxID_OK)
         {
-          item.set_item(
-            _("Type"),
-            m_frame->stc_entry_dialog_component()->get_text());
+          if (m_data.owner_data())
+          {
+            set_item(
+              item_number,
+              find_column(_("Type")),
+              m_frame->stc_entry_dialog_component()->get_text());
+          }
+          else
+          {
+            item.set_item(
+              _("Type"),
+              m_frame->stc_entry_dialog_component()->get_text());
+          }
         }
       }
   }
@@ -863,7 +1053,22 @@ bool wex::listview::item_from_text(const std::string& text)
       default:
         modified = true;
 
-        if (!InReportView())
+        if (m_data.owner_data())
+        {
+          // An item as saved, keeping empty columns.
+          const boost::tokenizer<boost::char_separator<char>> tok(
+            it,
+            boost::char_separator<char>(
+              std::string(1, m_field_separator).c_str(),
+              "",
+              boost::keep_empty_tokens));
+
+          if (!insert_item(std::vector<std::string>(tok.begin(), tok.end())))
+          {
+            return false;
+          }
+        }
+        else if (!InReportView())
         {
           listitem(this, path(it)).insert();
         }
@@ -887,7 +1092,7 @@ const std::string wex::listview::item_to_text(long item_number) const
   {
     for (auto i = 0; i < GetItemCount(); i++)
     {
-      text += GetItemText(i) + "\n";
+      text += item_text(i, 0) + "\n";
     }
 
     return text;
@@ -916,12 +1121,12 @@ const std::string wex::listview::item_to_text(long item_number) const
     break;
 
     case data::listview::FOLDER:
-      return GetItemText(item_number);
+      return item_text(item_number, 0);
 
     default:
       for (int col = 0; col < GetColumnCount(); col++)
       {
-        text += GetItemText(item_number, col);
+        text += item_text(item_number, col);
 
         if (col < GetColumnCount() - 1)
         {
@@ -933,11 +1138,17 @@ const std::string wex::listview::item_to_text(long item_number) const
   return text;
 }
 
+const std::string wex::listview::item_text(long item_number, int col) const
+{
+  return m_data.owner_data() ? m_store.get(item_number, col) :
+                               GetItemText(item_number, col).ToStdString();
+}
+
 void wex::listview::items_update()
 {
   if (
     m_data.type() != data::listview::NONE &&
-    m_data.type() != data::listview::TSV)
+    m_data.type() != data::listview::TSV && !m_data.owner_data())
   {
     for (auto i = 0; i < GetItemCount(); i++)
     {
@@ -1035,6 +1246,11 @@ bool wex::listview::on_command(const wxCommandEvent& event)
   return false;
 }
 
+wxString wex::listview::OnGetItemText(long item, long column) const
+{
+  return m_store.get(item, column);
+}
+
 void wex::listview::print()
 {
   wxBusyCursor wait;
@@ -1047,6 +1263,24 @@ void wex::listview::print_preview()
   printing::get()->get_html_printer()->PreviewText(build_page());
 }
 
+void wex::listview::process_changed(const path& p)
+{
+  if (!config("AllowSync").get(true))
+  {
+    return;
+  }
+
+  for (long i = 0; i < GetItemCount(); i++)
+  {
+    if (file_watcher::normal(listitem(this, i).path()) == p)
+    {
+      sync_item(i);
+    }
+  }
+
+  sync_sort();
+}
+
 void wex::listview::process_idle(wxIdleEvent& event)
 {
   event.Skip();
@@ -1057,40 +1291,21 @@ void wex::listview::process_idle(wxIdleEvent& event)
   {
     return;
   }
-  if (m_item_number < GetItemCount())
-  {
-    if (
-      listitem item(this, m_item_number);
-      item.path().file_exists() &&
-      (item.path().stat().get_modification_time_str() !=
-         get_item_text(m_item_number, _("Modified")) ||
-       item.path().stat().is_readonly() != item.is_readonly()))
-    {
-      item.update();
-      log::status() << item.path();
-      m_item_updated = true;
-    }
 
+  if (m_watch_id != 0)
+  {
+    // The items are watched, changes are handled by process_changed.
+    watch_items();
+  }
+  else if (m_item_number < GetItemCount())
+  {
+    sync_item(m_item_number);
     m_item_number++;
   }
   else
   {
     m_item_number = 0;
-
-    if (m_item_updated)
-    {
-      if (m_data.type() == data::listview::FILE)
-      {
-        if (
-          config("list.SortSync").get(true) &&
-          sorted_column_no() == find_column(_("Modified")))
-        {
-          sort_column(_("Modified"), SORT_KEEP);
-        }
-      }
-
-      m_item_updated = false;
-    }
+    sync_sort();
   }
 }
 
@@ -1134,21 +1349,55 @@ void wex::listview::process_list(const wxListEvent& event, wxEventType type)
 
 void wex::listview::process_match(const wxCommandEvent& event)
 {
+  // Without data, matches are available in the ring.
+  if (event.GetClientData() == nullptr)
+  {
+    process_matches();
+    return;
+  }
+
   const auto* m = static_cast<path_match*>(event.GetClientData());
-  listitem    item(this, m->path());
-
-  item.insert();
-  item.set_item(_("Line No"), std::to_string(m->line_no() + 1));
-  item.set_item(_("Line"), m->context());
-  item.set_item(
-    _("Match"),
-    m->tool().id() == ID_TOOL_REPORT_FIND ?
-      find_replace_data::get()->get_find_string() :
-      find_replace_data::get()->get_replace_string());
+
+  insert_match(*m);
+
+  if (m_data.owner_data())
+  {
+    SetItemCount(m_store.size());
+  }
 
   delete m;
 }
 
+void wex::listview::process_matches()
+{
+  if (m_matches == nullptr)
+  {
+    return;
+  }
+
+  Freeze();
+
+  m_matches->take(
+    [this](const path_match& m)
+    {
+      insert_match(m);
+    },
+    match_batch_size);
+
+  if (m_data.owner_data())
+  {
+    SetItemCount(m_store.size());
+  }
+
+  Thaw();
+
+  // A next batch after other events are processed.
+  if (!m_matches->empty())
+  {
+    wxPostEvent(this, wxCommandEvent(wxEVT_MENU, ID_LIST_MATCH));
+  }
+}
+
 void wex::listview::process_mouse(const wxMouseEvent& event)
 {
   menu::menu_t style(menu::menu_t().set(menu::IS_POPUP).set(menu::IS_VISUAL));
@@ -1244,72 +1493,48 @@ const wex::strings_t wex::listview::save() const
   return l;
 }
 
-std::vector<std::string>* pitems;
-
-int wxCALLBACK compare_cb(wxIntPtr item1, wxIntPtr item2, wxIntPtr sortData)
+namespace wex
 {
-  const bool  ascending = (sortData > 0);
-  const auto& str1      = (*pitems)[item1];
-  const auto& str2      = (*pitems)[item2];
-
-  // should return 0 if the items are equal,
-  // negative value if the first item is less than the second one
-  // and positive value if the first one is greater than the second one
+// A sort key, decoded once from the column text, empty text and
+// an invalid date have no key, and are sorted first.
+typedef std::variant<std::monostate, long long, double, std::string> sort_key_t;
 
-  if (str1.empty() && str2.empty())
-  {
-    return 0;
-  }
-  if (str1.empty())
-  {
-    return -1;
-  }
-  if (str2.empty())
+sort_key_t sort_key(const std::string& text, column::type_t type)
+{
+  if (text.empty())
   {
-    return 1;
+    return {};
   }
 
-  switch (const auto type = (wex::column::type_t)std::abs(sortData); type)
+  switch (type)
   {
-    case wex::column::DATE:
-    {
-      const auto& t1(wex::chrono().get_time(str1));
-      const auto& t2(wex::chrono().get_time(str2));
-      if (!t1 || !t2)
+    case column::DATE:
+      if (const auto& t(chrono().get_time(text)); t)
       {
-        return 0;
+        return static_cast<long long>(*t);
       }
+      return {};
 
-      return ascending ? wex::compare((unsigned long)*t1, (unsigned long)*t2) :
-                         wex::compare((unsigned long)*t2, (unsigned long)*t1);
-    }
-
-    case wex::column::FLOAT:
-      return ascending ? wex::compare(std::stof(str1), std::stof(str2)) :
-                         wex::compare(std::stof(str2), std::stof(str1));
+    case column::FLOAT:
+      return std::stod(text);
 
-    case wex::column::INT:
-      return ascending ? wex::compare(std::stoi(str1), std::stoi(str2)) :
-                         wex::compare(std::stoi(str2), std::stoi(str1));
-
-    case wex::column::STRING_SMALL:
-    case wex::column::STRING_MEDIUM:
-    case wex::column::STRING_LARGE:
-      if (!wex::find_replace_data::get()->match_case())
-      {
-        return ascending ? wex::icompare(str1, str2) :
-                           wex::icompare(str2, str1);
-      }
-      else
-      {
-        return ascending ? str1.compare(str2) : str2.compare(str1);
-      }
+    case column::INT:
+      return std::stoll(text);
 
     default:
-      assert(0);
+      return find_replace_data::get()->match_case() ?
+               text :
+               boost::algorithm::to_upper_copy(text);
   }
+}
+} // namespace wex
 
-  return 0;
+int wxCALLBACK compare_cb(wxIntPtr item1, wxIntPtr item2, wxIntPtr sortData)
+{
+  // The sort data is the rank of each item.
+  const auto& rank = *reinterpret_cast<const std::vector<long>*>(sortData);
+
+  return wex::compare(rank[item1], rank[item2]);
 }
 
 bool wex::listview::set_item(long index, int column, const std::string& text)
@@ -1342,6 +1567,13 @@ bool wex::listview::set_item(long index, int column, const std::string& text)
         break;
     }
 
+    if (m_data.owner_data())
+    {
+      m_store.set(index, column, text);
+      RefreshItem(index);
+      return true;
+    }
+
     return SetItem(index, column, text);
   }
   catch (std::exception& e)
@@ -1360,28 +1592,81 @@ bool wex::listview::sort_column(int column_no, sort_t sort_method)
 
   wxBusyCursor wait;
 
+  // Items are moved, a running watch pass might miss some.
+  if (m_item_number > 0)
+  {
+    m_watch_count = -1;
+  }
+
   sort_column_reset();
 
   auto& sorted_col = m_columns[column_no];
 
   sorted_col.set_is_sorted_ascending(sort_method);
 
-  std::vector<std::string> items;
-  pitems = &items;
-
-  for (int i = 0; i < GetItemCount(); i++)
-  {
-    items.emplace_back(GetItemText(i, column_no));
-    SetItemData(i, i);
-  }
-
   try
   {
-    const auto sortdata =
-      (sorted_col.is_sorted_ascending() ? sorted_col.type() :
-                                          (0 - sorted_col.type()));
+    // Decode the column texts once into keys, sort on the keys,
+    // and let SortItems apply the resulting rank.
+    std::vector<sort_key_t> keys;
+    keys.reserve(GetItemCount());
+
+    for (int i = 0; i < GetItemCount(); i++)
+    {
+      if (!m_data.owner_data())
+      {
+        keys.emplace_back(sort_key(
+          GetItemText(i, column_no).ToStdString(),
+          sorted_col.type()));
+        SetItemData(i, i);
+      }
+      else if (const auto& v(m_store.get_number(i, column_no)); v)
+      {
+        keys.emplace_back(*v);
+      }
+      else
+      {
+        keys.emplace_back(
+          sort_key(m_store.get(i, column_no), sorted_col.type()));
+      }
+    }
+
+    std::vector<long> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::ranges::stable_sort(
+      order,
+      [&keys, ascending = sorted_col.is_sorted_ascending()](long a, long b)
+      {
+        const auto& x(keys[a]);
+        const auto& y(keys[b]);
+
+        // Items without key are always first.
+        if (x.index() == 0 || y.index() == 0)
+        {
+          return x.index() == 0 && y.index() != 0;
+        }
+
+        return ascending ? x < y : y < x;
+      });
+
+    if (m_data.owner_data())
+    {
+      m_store.reorder(order);
+      Refresh();
+    }
+    else
+    {
+      std::vector<long> rank(order.size());
+
+      for (size_t i = 0; i < order.size(); i++)
+      {
+        rank[order[i]] = i;
+      }
+
+      SortItems(compare_cb, reinterpret_cast<wxIntPtr>(&rank));
+    }
 
-    SortItems(compare_cb, sortdata);
     ShowSortIndicator(column_no, sorted_col.is_sorted_ascending());
 
     m_sorted_column_no = column_no;
@@ -1410,3 +1695,71 @@ void wex::listview::sort_column_reset()
     m_sorted_column_no = -1;
   }
 }
+
+void wex::listview::sync_item(long item_number)
+{
+  if (
+    listitem item(this, item_number);
+    item.path().file_exists() &&
+    (item.path().stat().get_modification_time_str() !=
+       get_item_text(item_number, _("Modified")) ||
+     item.path().stat().is_readonly() != item.is_readonly()))
+  {
+    item.update();
+    log::status() << item.path();
+    m_item_updated = true;
+  }
+}
+
+void wex::listview::sync_sort()
+{
+  if (!m_item_updated)
+  {
+    return;
+  }
+
+  if (
+    m_data.type() == data::listview::FILE &&
+    config("list.SortSync").get(true) &&
+    sorted_column_no() == find_column(_("Modified")))
+  {
+    sort_column(_("Modified"), SORT_KEEP);
+  }
+
+  m_item_updated = false;
+}
+
+void wex::listview::watch_items()
+{
+  // The paths of all items are collected in a pass over the items in
+  // time slices, a new pass starts if items are inserted or deleted.
+  if (m_item_number == 0)
+  {
+    if (m_watch_count == GetItemCount())
+    {
+      return;
+    }
+
+    m_watch_count = GetItemCount();
+    m_watch_paths.clear();
+  }
+
+  for (const auto last = std::min<long>(m_item_number + 100, GetItemCount());
+       m_item_number < last;
+       m_item_number++)
+  {
+    m_watch_paths.emplace_back(listitem(this, m_item_number).path());
+  }
+
+  if (m_item_number >= GetItemCount())
+  {
+    if (!file_watcher::set(m_watch_id, m_watch_paths))
+    {
+      // The items are checked on idle instead.
+      file_watcher::unsubscribe(m_watch_id);
+      m_watch_id = 0;
+    }
+
+    m_item_number = 0;
+  }
+}
@@ -0,0 +1,379 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      blame-cache.cpp
+// Purpose:   Implementation of class wex::blame_cache
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/core/log.h>
+#include <wex/factory/process.h>
+#include <wex/factory/vcs.h>
+#include <wex/vcs/blame-cache.h>
+
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace wex
+{
+// Returns the first line of the file, or empty string.
+std::string first_line(const std::filesystem::path& p)
+{
+  std::string   line;
+  std::ifstream fs(p);
+  std::getline(fs, line);
+  return line;
+}
+
+// Returns the text after the key, if the line starts with it.
+std::optional<std::string_view>
+value_of(std::string_view line, std::string_view key)
+{
+  if (
+    !line.starts_with(key) || line.size() <= key.size() ||
+    line[key.size()] != ' ')
+  {
+    return std::nullopt;
+  }
+
+  return line.substr(key.size() + 1);
+}
+
+template <typename T> T to_number(std::string_view text)
+{
+  T v{0};
+  std::from_chars(text.data(), text.data() + text.size(), v);
+  return v;
+}
+} // namespace wex
+
+struct wex::blame_cache::state
+{
+  struct file
+  {
+    path   toplevel;
+    stamp  current;
+    blamed result;
+    bool   is_blamed{false}, is_running{false};
+
+    std::chrono::steady_clock::time_point checked;
+
+    std::jthread thread;
+  };
+
+  std::mutex mutex;
+
+  std::unordered_map<std::string, file> files;
+
+  notify_t notify;
+
+  bool closed{false};
+};
+
+wex::blame_cache::blame_cache(notify_t notify)
+  : m_state(std::make_shared<state>())
+{
+  m_state->notify = std::move(notify);
+}
+
+wex::blame_cache::~blame_cache()
+{
+  std::vector<std::jthread> threads;
+
+  {
+    std::lock_guard lock(m_state->mutex);
+    m_state->closed = true;
+
+    for (auto& it : m_state->files)
+    {
+      threads.emplace_back(std::move(it.second.thread));
+    }
+  }
+
+  // The threads are joined without the lock, as they need it to finish.
+  threads.clear();
+}
+
+std::optional<wex::blame_cache::commit>
+wex::blame_cache::find(const path& p, int line)
+{
+  if (line < 0)
+  {
+    return std::nullopt;
+  }
+
+  std::unique_lock lock(m_state->mutex);
+
+  auto it = m_state->files.find(p.string());
+
+  if (it == m_state->files.end())
+  {
+    if (!p.file_exists())
+    {
+      return std::nullopt;
+    }
+
+    it = m_state->files.emplace(p.string(), state::file()).first;
+  }
+
+  auto& f(it->second);
+
+  // The file and the git HEAD are checked at most once a second,
+  // otherwise a find only looks up the line.
+  if (const auto now = std::chrono::steady_clock::now();
+      !f.is_running &&
+      (!f.is_blamed || now - f.checked >= std::chrono::seconds(1)))
+  {
+    f.checked = now;
+
+    if (f.toplevel.empty())
+    {
+      f.toplevel = factory::vcs_admin(".git", p).toplevel();
+
+      if (f.toplevel.empty())
+      {
+        return std::nullopt;
+      }
+    }
+
+    const auto toplevel(f.toplevel);
+
+    lock.unlock();
+    const auto s(get_stamp(p, toplevel));
+    lock.lock();
+
+    if (f.is_running)
+    {
+      return std::nullopt;
+    }
+
+    if (s != f.current || !f.is_blamed)
+    {
+      f.current    = s;
+      f.is_blamed  = false;
+      f.is_running = true;
+      f.result     = blamed();
+
+      // A previous thread no longer uses the file, joining it
+      // does not wait long.
+      f.thread = std::jthread(
+        [state = m_state, p, s]
+        {
+          factory::process process;
+
+          const bool ok =
+            process.system(process_data("git")
+                             .args("blame --porcelain " + p.filename())
+                             .start_dir(p.parent_path())) == 0;
+
+          auto b(ok ? parse(process.std_out()) : blamed());
+
+          {
+            std::lock_guard lock(state->mutex);
+
+            if (state->closed)
+            {
+              return;
+            }
+
+            auto& f(state->files[p.string()]);
+
+            f.is_running = false;
+
+            // If the file changed meanwhile, it is blamed again on next
+            // find, otherwise it is not blamed again, even if git failed.
+            if (f.current == s)
+            {
+              f.result    = std::move(b);
+              f.is_blamed = true;
+            }
+          }
+
+          if (ok && state->notify != nullptr)
+          {
+            state->notify(p);
+          }
+        });
+
+      return std::nullopt;
+    }
+  }
+
+  if (!f.is_blamed || static_cast<size_t>(line) >= f.result.lines.size())
+  {
+    return std::nullopt;
+  }
+
+  const auto& c(f.result.commits[f.result.lines[line]]);
+
+  return c.id.starts_with("000000") ? std::nullopt : std::optional(c);
+}
+std::string wex::blame_cache::format(const commit& c, const std::string& fmt)
+{
+  std::string text;
+
+  for (size_t i = 0; i < fmt.size(); i++)
+  {
+    const std::string_view rest(fmt.data() + i, fmt.size() - i);
+
+    if (rest.starts_with("%an"))
+    {
+      text += c.author;
+      i += 2;
+    }
+    else if (rest.starts_with("%ad"))
+    {
+      // the short date in the author timezone, as git --date=short
+      const time_t t = c.time + c.tz;
+      char         buffer[16];
+
+      if (const auto* tm = std::gmtime(&t);
+          tm != nullptr &&
+          std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", tm) > 0)
+      {
+        text += buffer;
+      }
+
+      i += 2;
+    }
+    else if (rest.starts_with("%H"))
+    {
+      text += c.id;
+      i++;
+    }
+    else if (rest.starts_with("%h"))
+    {
+      text += c.id.substr(0, 7);
+      i++;
+    }
+    else if (rest.starts_with("%s"))
+    {
+      text += c.summary;
+      i++;
+    }
+    else
+    {
+      text += fmt[i];
+    }
+  }
+
+  return text;
+}
+
+wex::blame_cache::stamp
+wex::blame_cache::get_stamp(const path& p, const path& toplevel)
+{
+  std::error_code ec;
+  stamp           s{std::filesystem::last_write_time(p.data(), ec), ""};
+
+  // The .git might be a file referring to the git dir, e.g. for a worktree.
+  auto git(toplevel.data() / ".git");
+
+  if (std::filesystem::is_regular_file(git, ec))
+  {
+    if (const auto& v(value_of(first_line(git), "gitdir:")); v)
+    {
+      git = toplevel.data() / std::filesystem::path(std::string(*v));
+    }
+  }
+
+  // The HEAD refers to a branch, that changes after a commit,
+  // or is a commit itself.
+  s.head = first_line(git / "HEAD");
+
+  if (const auto& v(value_of(s.head, "ref:")); v)
+  {
+    auto ref(git / std::string(*v));
+
+    if (!std::filesystem::exists(ref, ec))
+    {
+      ref = git / "packed-refs";
+    }
+
+    s.head += ":" + std::to_string(std::filesystem::last_write_time(ref, ec)
+                                     .time_since_epoch()
+                                     .count());
+  }
+
+  return s;
+}
+
+wex::blame_cache::blamed wex::blame_cache::parse(const std::string& text)
+{
+  blamed                                    b;
+  std::unordered_map<std::string, uint32_t> ids;
+  commit*                                   current = nullptr;
+  std::string_view                          rest(text);
+
+  while (!rest.empty())
+  {
+    const auto       pos = rest.find('\n');
+    std::string_view line(rest.substr(0, pos));
+    rest.remove_prefix(pos == std::string_view::npos ? rest.size() : pos + 1);
+
+    if (line.empty() || line.front() == '\t')
+    {
+      // the line text ends the lines of a blamed line
+      current = nullptr;
+    }
+    else if (current == nullptr)
+    {
+      // <hash> <original line> <final line> [<lines in group>]
+      const auto original = line.find(' ');
+      const auto final    = line.find(' ', original + 1);
+
+      if (
+        original == std::string_view::npos || final == std::string_view::npos)
+      {
+        log("blame cache parse") << std::string(line);
+        return blamed();
+      }
+
+      const std::string id(line.substr(0, original));
+      const auto        final_line = to_number<uint32_t>(
+        line.substr(final + 1, line.find(' ', final + 1) - final - 1));
+
+      auto [it, inserted] = ids.try_emplace(id, b.commits.size());
+
+      if (inserted)
+      {
+        b.commits.push_back({id});
+      }
+
+      if (final_line > 0)
+      {
+        if (b.lines.size() < final_line)
+        {
+          b.lines.resize(final_line);
+        }
+
+        b.lines[final_line - 1] = it->second;
+      }
+
+      current = &b.commits[it->second];
+    }
+    else if (const auto& v(value_of(line, "author")); v)
+    {
+      current->author = *v;
+    }
+    else if (const auto& v(value_of(line, "author-time")); v)
+    {
+      current->time = to_number<time_t>(*v);
+    }
+    else if (const auto& v(value_of(line, "author-tz")); v && v->size() == 5)
+    {
+      const int hhmm = to_number<int>(v->substr(1));
+      current->tz    = (hhmm / 100 * 3600 + hhmm % 100 * 60) *
+                    (v->front() == '-' ? -1 : 1);
+    }
+    else if (const auto& v(value_of(line, "summary")); v)
+    {
+      current->summary = *v;
+    }
+  }
+
+  return b;
+}
@@ -97,6 +97,22 @@ TEST_CASE("wex::dir")
 
       std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
+
+    SECTION("threads")
+    {
+      wex::dir dir(
+        wex::path("./"),
+        wex::data::dir().file_spec("*.h").threads(2).ordered(false),
+        get_listview());
+
+      REQUIRE(dir.data().threads() == 2);
+      REQUIRE(!dir.data().is_ordered());
+      REQUIRE(dir.find_files(wex::tool(wex::ID_TOOL_REPORT_FIND)));
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      wex::interruptible::end();
+    }
   }
 
   SECTION("get_all_files")
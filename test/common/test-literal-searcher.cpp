@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-literal-searcher.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/algorithm/string.hpp>
+#include <wex/common/literal-searcher.h>
+#include <wex/test/test.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <sstream>
+
+TEST_CASE("wex::literal_searcher")
+{
+  SECTION("constructor")
+  {
+    REQUIRE(wex::literal_searcher("").empty());
+    REQUIRE(wex::literal_searcher("").find("xyz") == std::string::npos);
+    REQUIRE(wex::literal_searcher("test").size() == 4);
+  }
+
+  SECTION("find")
+  {
+    const wex::literal_searcher s("test");
+
+    REQUIRE(s.find("test") == 0);
+    REQUIRE(s.find("a test") == 2);
+    REQUIRE(s.find("a TEST") == std::string::npos);
+    REQUIRE(s.find("tes") == std::string::npos);
+    REQUIRE(s.find("test test", 1) == 5);
+    REQUIRE(s.find("test", 1) == std::string::npos);
+    REQUIRE(s.find("test", 10) == std::string::npos);
+
+    // A long text, so the blocks are used.
+    const std::string text(std::string(1000, 'x') + "tesT test");
+    REQUIRE(s.find(text) == 1005);
+  }
+
+  SECTION("find-no-case")
+  {
+    const wex::literal_searcher s("TeSt_1", false);
+
+    REQUIRE(s.find("a test_1") == 2);
+    REQUIRE(s.find("a TEST_1") == 2);
+    REQUIRE(s.find("a TEST_!") == std::string::npos);
+    REQUIRE(s.find(std::string(100, '@') + "TEST_1") == 100);
+
+    // The fold is ASCII only.
+    REQUIRE(wex::literal_searcher("@", false).find("`") == std::string::npos);
+    REQUIRE(wex::literal_searcher("[", false).find("{") == std::string::npos);
+  }
+
+  SECTION("find-word")
+  {
+    const wex::literal_searcher s("test", true, true);
+
+    REQUIRE(s.find("test") == 0);
+    REQUIRE(s.find("a test.") == 2);
+    REQUIRE(s.find("a tests") == std::string::npos);
+    REQUIRE(s.find("_test") == std::string::npos);
+
+    // Not only the first match is checked.
+    REQUIRE(s.find("tests test") == 6);
+  }
+
+  SECTION("find_all")
+  {
+    const wex::literal_searcher s("aa");
+    std::vector<size_t>         pos;
+
+    REQUIRE(
+      s.find_all(
+        "aaaxaa",
+        [&pos](size_t p)
+        {
+          pos.emplace_back(p);
+          return true;
+        }) == 2);
+    REQUIRE(pos == std::vector<size_t>{0, 4});
+
+    REQUIRE(
+      s.find_all(
+        "aaaxaa",
+        [](size_t)
+        {
+          return false;
+        }) == 1);
+  }
+
+  SECTION("same-as-boyer-moore")
+  {
+    std::string text;
+
+    for (int i = 0; i < 1000; i++)
+    {
+      text += std::to_string(i * 7919) + (i % 3 == 0 ? "Ab" : "aB");
+    }
+
+    for (const auto& find : std::vector<std::string>{"1", "ab", "9aB", "23"})
+    {
+      auto text_find(text), find_upper(find);
+      boost::algorithm::to_upper(text_find);
+      boost::algorithm::to_upper(find_upper);
+
+      std::vector<size_t> expected, result;
+
+      const std::boyer_moore_searcher searcher(
+        find_upper.begin(),
+        find_upper.end());
+
+      for (auto it = text_find.begin();
+           (it = std::search(it, text_find.end(), searcher)) != text_find.end();
+           it += find.size())
+      {
+        expected.emplace_back(it - text_find.begin());
+      }
+
+      wex::literal_searcher(find, false)
+        .find_all(
+          text,
+          [&result](size_t p)
+          {
+            result.emplace_back(p);
+            return true;
+          });
+
+      CAPTURE(find);
+      REQUIRE(result == expected);
+    }
+  }
+}
+
+TEST_CASE("wex::literal_searcher-benchmark", "[.benchmark]")
+{
+  // Synthetic corpus, lines with some matches.
+  const std::string line(
+    "    const auto milli = std::chrono::duration_cast<milliseconds>(x);\n");
+  const std::string match("    REQUIRE(s.find(\"wex::Literal_Searcher\"));\n");
+  std::string       corpus;
+
+  while (corpus.size() < 64 * 1024 * 1024)
+  {
+    corpus += (corpus.size() % 100 == 0 ? match : line);
+  }
+
+  const std::string find("LITERAL_SEARCHER");
+
+  // The old way, per line a copy to upper and a boyer moore search.
+  const auto start_old = std::chrono::steady_clock::now();
+  size_t     lines_old = 0;
+
+  std::stringstream ss(corpus);
+
+  for (std::string l; std::getline(ss, l);)
+  {
+    auto text_find(l);
+    boost::algorithm::to_upper(text_find);
+
+    if (
+      std::search(
+        text_find.begin(),
+        text_find.end(),
+        std::boyer_moore_searcher(find.begin(), find.end())) !=
+      text_find.end())
+    {
+      lines_old++;
+    }
+  }
+
+  const auto milli_old =
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_old);
+
+  // The searcher on the raw buffer.
+  const auto start = std::chrono::steady_clock::now();
+
+  const auto lines = wex::literal_searcher(find, false)
+                       .find_all(
+                         corpus,
+                         [](size_t)
+                         {
+                           return true;
+                         });
+
+  const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+  const auto mb = corpus.size() / (1024.0 * 1024.0);
+
+  WARN(
+    "literal_searcher: " << mb << " MB, per line " << milli_old.count()
+                         << " ms, searcher " << milli.count() << " ms, "
+                         << mb * 1000 / std::max<long>(milli.count(), 1)
+                         << " MB/s");
+
+  REQUIRE(lines == lines_old);
+}
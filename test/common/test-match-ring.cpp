@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-match-ring.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/common/match-ring.h>
+#include <wex/test/test.h>
+
+#include <algorithm>
+#include <thread>
+
+TEST_CASE("wex::match_ring")
+{
+  const wex::path p("xxx");
+  const wex::tool t(wex::ID_TOOL_REPORT_FIND);
+
+  int notified = 0;
+
+  auto ring = std::make_shared<wex::match_ring>(
+    5,
+    [&notified]
+    {
+      notified++;
+    });
+
+  SECTION("constructor")
+  {
+    REQUIRE(ring->capacity() == 8);
+    REQUIRE(ring->empty());
+    REQUIRE(ring->size() == 0);
+  }
+
+  SECTION("push-take")
+  {
+    for (size_t i = 0; i < 5; i++)
+    {
+      REQUIRE(ring->push(wex::path_match(p, t, "line", i, 0)));
+    }
+
+    // Only the first push notifies.
+    REQUIRE(notified == 1);
+    REQUIRE(ring->size() == 5);
+
+    std::vector<size_t> lines;
+    const auto          add = [&lines](const wex::path_match& m)
+    {
+      lines.emplace_back(m.line_no());
+    };
+
+    REQUIRE(ring->take(add, 2) == 2);
+    REQUIRE(ring->take(add) == 3);
+    REQUIRE(ring->take(add) == 0);
+    REQUIRE(lines == std::vector<size_t>{0, 1, 2, 3, 4});
+
+    REQUIRE(ring->push(wex::path_match(p, t, "line", 5, 0)));
+    REQUIRE(notified == 2);
+  }
+
+  SECTION("close")
+  {
+    ring->close();
+    REQUIRE(!ring->push(wex::path_match(p)));
+    REQUIRE(ring->empty());
+  }
+
+  SECTION("registry")
+  {
+    auto* eh = reinterpret_cast<wxEvtHandler*>(&notified);
+
+    REQUIRE(wex::match_ring::get(eh) == nullptr);
+
+    wex::match_ring::set(eh, ring);
+    REQUIRE(wex::match_ring::get(eh) == ring);
+
+    wex::match_ring::set(eh, nullptr);
+    REQUIRE(wex::match_ring::get(eh) == nullptr);
+    REQUIRE(!ring->push(wex::path_match(p)));
+  }
+
+  SECTION("back-pressure")
+  {
+    // The producer pushes more matches than the capacity,
+    // and waits for the consumer.
+    const size_t matches = 10000;
+
+    std::thread producer(
+      [&]
+      {
+        for (size_t i = 0; i < matches; i++)
+        {
+          ring->push(wex::path_match(p, t, "line", i, 0));
+        }
+      });
+
+    std::vector<size_t> lines;
+
+    while (lines.size() < matches)
+    {
+      REQUIRE(ring->size() <= ring->capacity());
+
+      ring->take(
+        [&lines](const wex::path_match& m)
+        {
+          lines.emplace_back(m.line_no());
+        },
+        3);
+    }
+
+    producer.join();
+
+    REQUIRE(ring->empty());
+    REQUIRE(std::ranges::is_sorted(lines));
+    REQUIRE(lines.back() == matches - 1);
+  }
+}
@@ -5,6 +5,9 @@
 // Copyright: (c) 2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <thread>
+#include <vector>
+
 #include <wex/common/stream-statistics.h>
 
 #include <wex/test/test.h>
@@ -32,3 +35,49 @@ TEST_CASE("wex::stream_statistics")
 
   REQUIRE(ss.get_elements().get_items().size() == 3);
 }
+
+TEST_CASE("wex::stream_statistics::counters")
+{
+  wex::stream_statistics ss;
+
+  REQUIRE(ss.empty());
+  REQUIRE(ss.inc(wex::stream_statistics::FOLDERS, 2) == 2);
+  REQUIRE(ss.get(wex::stream_statistics::FOLDERS) == 2);
+  REQUIRE(
+    ss.get(wex::stream_statistics::name(wex::stream_statistics::FOLDERS)) == 2);
+  REQUIRE(!ss.empty());
+
+  REQUIRE(
+    ss.inc(wex::stream_statistics::name(wex::stream_statistics::ACTIONS)) == 1);
+  REQUIRE(ss.get(wex::stream_statistics::ACTIONS) == 1);
+  REQUIRE(ss.get_elements().get_items().size() == 2);
+
+  const wex::stream_statistics copy(ss);
+  REQUIRE(copy.get(wex::stream_statistics::FOLDERS) == 2);
+
+  std::vector<std::thread> v;
+
+  for (int i = 0; i < 4; i++)
+  {
+    v.emplace_back(
+      [&ss]
+      {
+        for (int j = 0; j < 1000; j++)
+        {
+          ss.inc_actions_completed();
+          ss.inc("xx");
+        }
+      });
+  }
+
+  for (auto& t : v)
+  {
+    t.join();
+  }
+
+  REQUIRE(ss.get(wex::stream_statistics::ACTIONS_COMPLETED) == 4000);
+  REQUIRE(ss.get("xx") == 4000);
+
+  ss.clear();
+  REQUIRE(ss.empty());
+}
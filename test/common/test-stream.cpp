@@ -11,6 +11,9 @@
 #include <wex/test/test.h>
 
 #include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 
 void find_prep(wex::stream& s, wex::factory::find_replace_data* frd)
 {
@@ -112,4 +115,35 @@ TEST_CASE("wex::stream")
 
     REQUIRE(s.get_statistics().get("Actions Completed") == 195);
   }
+
+  SECTION("replace-file")
+  {
+    const std::string name("test-stream-replace.txt");
+    std::ofstream(name) << "a test\nno\ntest test";
+
+    frd.set_regex(false);
+    frd.set_find_string("test");
+    frd.set_replace_string("best");
+    frd.set_match_case(true);
+
+    wex::stream s(&frd, wex::path(name), wex::tool(wex::ID_TOOL_REPLACE));
+    REQUIRE(s.run_tool());
+    REQUIRE(s.get_statistics().get("Actions Completed") == 3);
+    REQUIRE(!std::filesystem::exists(name + ".wex-tmp"));
+
+    std::stringstream ss;
+    ss << std::ifstream(name).rdbuf();
+    REQUIRE(ss.str() == "a best\nno\nbest best");
+
+    // A file without match is not written.
+    const auto time(std::filesystem::last_write_time(name));
+    frd.set_find_string("xyz");
+
+    wex::stream t(&frd, wex::path(name), wex::tool(wex::ID_TOOL_REPLACE));
+    REQUIRE(t.run_tool());
+    REQUIRE(t.get_statistics().get("Actions Completed") == 0);
+    REQUIRE(std::filesystem::last_write_time(name) == time);
+
+    std::filesystem::remove(name);
+  }
 }
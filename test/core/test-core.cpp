@@ -10,10 +10,42 @@
 #include <wex/core/types.h>
 #include <wex/test/test.h>
 
+#include <chrono>
+
 TEST_CASE("wex::core")
 {
   wex::ints_t cs{'(', ')', '{', '}', '<', '>', '[', ']'};
 
+  SECTION("append_string_set")
+  {
+    std::string text("x ");
+    REQUIRE(wex::append_string_set(text, {"one", "two", "three"}, 0, "t") == 2);
+    REQUIRE(text == "x three two ");
+    REQUIRE(wex::append_string_set(text, {"one", "two"}, 0, "z") == 0);
+    REQUIRE(text == "x three two ");
+
+    // Many keywords, the prefix is seeked.
+    std::set<std::string> kset;
+    for (int i = 0; i < 100000; i++)
+    {
+      kset.emplace("keyword" + std::to_string(i));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < 1000; i++)
+    {
+      text.clear();
+      REQUIRE(wex::append_string_set(text, kset, 0, "keyword9999") == 11);
+    }
+
+    const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+    CAPTURE(milli.count());
+    REQUIRE(milli.count() < 100);
+  }
+
   SECTION("auto_complete_text")
   {
     const std::vector<std::string> v{"one_xxxx", "one_yyyyy", "one_z"};
@@ -15,6 +15,9 @@ TEST_CASE("wex::file_status")
   REQUIRE(stat.is_ok());
   REQUIRE(stat.get_access_time() != 0);
   REQUIRE(stat.get_creation_time() != 0);
+#ifdef __UNIX__
+  REQUIRE(stat.get_inode() != 0);
+#endif
   REQUIRE(stat.get_modification_time() != 0);
   REQUIRE(stat.get_size() != 0);
   REQUIRE(!stat.get_creation_time_str().empty());
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-file-watcher.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/core/file-watcher.h>
+#include <wex/test/test.h>
+
+#include <fstream>
+#include <thread>
+
+TEST_CASE("wex::file_watcher")
+{
+  REQUIRE(!wex::file_watcher::add(0, wex::path("xxx")));
+
+  if (!wex::file_watcher::is_supported())
+  {
+    REQUIRE(wex::file_watcher::subscribe(nullptr) == 0);
+    return;
+  }
+
+  const wex::path p(
+    std::filesystem::temp_directory_path() / "test-file-watcher.txt");
+
+  std::ofstream(p.data()) << "hello";
+
+  std::vector<std::string> changed;
+
+  const auto id = wex::file_watcher::subscribe(
+    [&changed](const wex::path& p)
+    {
+      changed.emplace_back(p.filename());
+    });
+
+  REQUIRE(id != 0);
+  REQUIRE(wex::file_watcher::add(id, p));
+
+  const auto wait = []
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    wxTheApp->ProcessPendingEvents();
+  };
+
+  SECTION("changed")
+  {
+    // All changes are delivered at once.
+    for (int i = 0; i < 10; i++)
+    {
+      std::ofstream(p.data(), std::ios_base::app) << "more";
+    }
+
+    wait();
+
+    REQUIRE(changed == std::vector<std::string>{"test-file-watcher.txt"});
+  }
+
+  SECTION("other file")
+  {
+    std::ofstream(p.data().string() + ".other") << "other";
+    wait();
+
+    REQUIRE(changed.empty());
+  }
+
+  SECTION("set")
+  {
+    const wex::path other(p.string() + ".other");
+
+    REQUIRE(wex::file_watcher::set(id, {other}));
+
+    std::ofstream(p.data(), std::ios_base::app) << "more";
+    std::ofstream(other.data()) << "other";
+    wait();
+
+    REQUIRE(changed == std::vector<std::string>{"test-file-watcher.txt.other"});
+    REQUIRE(
+      wex::file_watcher::normal(wex::path("./x/../test.h")) ==
+      wex::file_watcher::normal(wex::path("test.h")));
+  }
+
+  SECTION("not watched")
+  {
+    REQUIRE(!wex::file_watcher::add(id, wex::path("/xxx/yyy/zzz.txt")));
+    REQUIRE(!wex::file_watcher::set(id, {p, wex::path("/xxx/yyy/zzz.txt")}));
+  }
+
+  SECTION("symlink")
+  {
+    const auto dir(std::filesystem::temp_directory_path() / "test-fw-link");
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directory(dir);
+    std::filesystem::create_symlink(p.data(), dir / "link.txt");
+
+    REQUIRE(wex::file_watcher::set(id, {wex::path(dir / "link.txt")}));
+
+    std::ofstream(p.data(), std::ios_base::app) << "more";
+    wait();
+
+    REQUIRE(changed == std::vector<std::string>{"test-file-watcher.txt"});
+
+    std::filesystem::remove_all(dir);
+  }
+
+  SECTION("removed dir")
+  {
+    const auto dir(std::filesystem::temp_directory_path() / "test-fw-dir");
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directory(dir);
+    std::ofstream(dir / "file.txt") << "hello";
+
+    REQUIRE(wex::file_watcher::set(id, {wex::path(dir / "file.txt")}));
+
+    std::filesystem::remove_all(dir);
+    wait();
+
+    REQUIRE(changed == std::vector<std::string>{"file.txt"});
+
+    // The dir is watched again when present.
+    changed.clear();
+    std::filesystem::create_directory(dir);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+    wait();
+    changed.clear();
+
+    std::ofstream(dir / "file.txt") << "again";
+    wait();
+
+    REQUIRE(changed == std::vector<std::string>{"file.txt"});
+
+    std::filesystem::remove_all(dir);
+  }
+
+  SECTION("clear")
+  {
+    wex::file_watcher::clear(id);
+
+    std::ofstream(p.data(), std::ios_base::app) << "more";
+    wait();
+
+    REQUIRE(changed.empty());
+  }
+
+  wex::file_watcher::unsubscribe(id);
+  REQUIRE(!wex::file_watcher::add(id, p));
+  REQUIRE(!wex::file_watcher::set(id, {p}));
+
+  std::filesystem::remove(p.data());
+  std::filesystem::remove(p.data().string() + ".other");
+}
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-path-matcher.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/core/path-matcher.h>
+#include <wex/test/test.h>
+
+TEST_CASE("wex::path_matcher")
+{
+  SECTION("constructor")
+  {
+    REQUIRE(wex::path_matcher().empty());
+    REQUIRE(!wex::path_matcher().matches("test.txt"));
+    REQUIRE(wex::path_matcher("*.txt").patterns() == "*.txt");
+    REQUIRE(!wex::path_matcher("*.txt").empty());
+  }
+
+  SECTION("all")
+  {
+    REQUIRE(wex::path_matcher("*").matches("test.txt"));
+    REQUIRE(wex::path_matcher("*").matches(""));
+    REQUIRE(!wex::path_matcher("*.txt").matches(""));
+  }
+
+  SECTION("extensions")
+  {
+    const wex::path_matcher m("*.cpp;*.h;*.tar.gz");
+
+    REQUIRE(m.matches("test.cpp"));
+    REQUIRE(m.matches("test.h"));
+    REQUIRE(m.matches(".h"));
+    REQUIRE(m.matches("test.tar.gz"));
+    REQUIRE(!m.matches("test.gz"));
+    REQUIRE(!m.matches("test.cpp.bak"));
+    REQUIRE(!m.matches("cpp"));
+  }
+
+  SECTION("glob")
+  {
+    const wex::path_matcher m("Makefile;*makefile;makefile*.*;a?c;hosts*");
+
+    REQUIRE(m.matches("Makefile"));
+    REQUIRE(m.matches("gnumakefile"));
+    REQUIRE(m.matches("makefile.am"));
+    REQUIRE(!m.matches("makefileam"));
+    REQUIRE(m.matches("ac"));
+    REQUIRE(m.matches("abc"));
+    REQUIRE(!m.matches("abbc"));
+    REQUIRE(m.matches("hosts.allow"));
+    REQUIRE(!m.matches("myhosts"));
+  }
+
+  SECTION("regex")
+  {
+    REQUIRE(!wex::path_matcher("*.txt", true).matches("test.txt"));
+    REQUIRE(wex::path_matcher(".*.txt", true).matches("test.txt"));
+    REQUIRE(wex::path_matcher("est.txt", true).matches("test.txt"));
+    REQUIRE(wex::path_matcher("xx;^te", true).matches("test.txt"));
+  }
+}
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-regex-substitute.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/core/regex-substitute.h>
+#include <wex/test/test.h>
+
+TEST_CASE("wex::regex_substitute")
+{
+  SECTION("constructor")
+  {
+    REQUIRE(wex::regex_substitute("abc", "x").is_ok());
+    REQUIRE(!wex::regex_substitute("(", "x").is_ok());
+    REQUIRE(!wex::regex_substitute(boost::regex(), "x").is_ok());
+    REQUIRE(wex::regex_substitute("abc", "x").prefix() == "abc");
+    REQUIRE(wex::regex_substitute("^abc", "x").prefix() == "abc");
+    REQUIRE(wex::regex_substitute("ab?c", "x").prefix() == "a");
+    REQUIRE(wex::regex_substitute("foo(bar)?x", "x").prefix() == "foo");
+    REQUIRE(wex::regex_substitute("a|b", "x").prefix().empty());
+    REQUIRE(wex::regex_substitute(".*", "x").prefix().empty());
+    REQUIRE(
+      wex::regex_substitute("abc", "x", boost::regex::icase).prefix().empty());
+    REQUIRE(wex::regex_substitute(boost::regex("xyz"), "x").prefix() == "xyz");
+  }
+
+  SECTION("replace")
+  {
+    const wex::regex_substitute s("b+", "X");
+
+    std::string text("abbcb");
+    int         pos = -1;
+    REQUIRE(s.replace(text, &pos) == 2);
+    REQUIRE(text == "aXcX");
+    REQUIRE(pos == 1);
+
+    text = "xyz";
+    pos  = -1;
+    REQUIRE(s.replace(text, &pos) == 0);
+    REQUIRE(text == "xyz");
+    REQUIRE(pos == -1);
+
+    std::string out("keep:");
+    REQUIRE(s.replace(std::string_view("b-b"), out) == 2);
+    REQUIRE(out == "keep:X-X");
+  }
+
+  SECTION("sed-format")
+  {
+    for (const auto& [regex, replacement, text, result] :
+         std::vector<
+           std::tuple<std::string, std::string, std::string, std::string>>{
+           {"(\\w+) (\\w+)", "\\2 \\1", "hello world", "world hello"},
+           {"o", "[&]", "foo", "f[o][o]"},
+           {"o", "\\&", "foo", "f&&"},
+           {"o", "\\n", "fo", "f\n"},
+           {"(a)|(b)", "<\\2>", "ab", "<><b>"},
+           {"x", "\\x41", "axa", "aAa"}})
+    {
+      CAPTURE(regex);
+      CAPTURE(replacement);
+
+      std::string text_copy(text);
+      wex::regex_substitute(regex, replacement).replace(text_copy);
+      REQUIRE(text_copy == result);
+
+      // Same result as boost.
+      REQUIRE(
+        text_copy == boost::regex_replace(
+                       text,
+                       boost::regex(regex),
+                       replacement,
+                       boost::regex_constants::format_sed));
+    }
+  }
+}
@@ -2,7 +2,7 @@
 // Name:      test-regex.cpp
 // Purpose:   Implementation for wex unit testing
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2021-2025 Anton van Wezenbeek
+// Copyright: (c) 2021-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <wex/core/log-none.h>
@@ -18,6 +18,29 @@ TEST_CASE("wex::regex::data")
 
 TEST_CASE("wex::regex")
 {
+  SECTION("cache")
+  {
+    const auto hits(wex::regex::cache_hits());
+    const auto misses(wex::regex::cache_misses());
+
+    REQUIRE(wex::regex("c[a-z]+che").match("cache") == 0);
+    REQUIRE(wex::regex::cache_misses() == misses + 1);
+
+    REQUIRE(wex::regex("c[a-z]+che").match("cxche") == 0);
+    REQUIRE(wex::regex::cache_hits() == hits + 1);
+    REQUIRE(wex::regex::cache_misses() == misses + 1);
+
+    // Other flags are another cache entry.
+    REQUIRE(wex::regex("c[a-z]+che", boost::regex::icase).match("CACHE") == 0);
+    REQUIRE(wex::regex::cache_misses() == misses + 2);
+
+    // Invalid regex are not cached.
+    wex::log_none off;
+    REQUIRE(wex::regex("c[a-z+che").match("cache") == -1);
+    REQUIRE(wex::regex("c[a-z+che").match("cache") == -1);
+    REQUIRE(wex::regex::cache_hits() == hits + 1);
+  }
+
   SECTION("constructor")
   {
     REQUIRE(wex::regex(std::string()).match("") == 0);
@@ -2,7 +2,7 @@
 // Name:      data/test-dir.cpp
 // Purpose:   Implementation for wex unit testing
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2021-2025 Anton van Wezenbeek
+// Copyright: (c) 2021-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <wex/data/dir.h>
@@ -22,6 +22,9 @@ TEST_CASE("wex::data::dir")
     REQUIRE(dir.file_spec("yy").file_spec() == "yy");
     REQUIRE(!dir.file_spec("yy").is_regex());
     REQUIRE(dir.file_spec("yy", true).is_regex());
+    REQUIRE(dir.file_spec("*.h").file_matcher().matches("test.h"));
+    REQUIRE(!dir.file_matcher().matches("test.cpp"));
+    REQUIRE(dir.dir_spec("d*").dir_matcher().matches("data"));
     REQUIRE(dir.find_replace_data() == nullptr);
     REQUIRE(dir.max_matches() == -1);
     REQUIRE(dir.max_matches(3).max_matches() == 3);
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-command-index.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+
+#include "../src/ex/command-index.h"
+#include "test.h"
+
+namespace
+{
+const std::vector<std::string> regex{
+  "^:ab(breviate)?\\b",
+  "^:chd(ir)?\\b|:cd\\b",
+  "^:e(dit)?\\b",
+  "^:q(uit)?!?\\b",
+  "^:set?\\b",
+  "^:u(ndo)?\\b",
+  "^:una(bbrev)?\\b",
+  "^:ve(rsion)?\\b"};
+} // namespace
+
+TEST_CASE("wex::command_index")
+{
+  const wex::command_index index(regex);
+
+  REQUIRE(index.size() == regex.size());
+
+  SECTION("find")
+  {
+    for (const auto& [command, pos] :
+         std::vector<std::pair<std::string, std::optional<size_t>>>{
+           {":ab x y", 0},
+           {":abbreviate", 0},
+           {":chdir /tmp", 1},
+           {":cd", 1},
+           {":e :cd", 1},
+           {":edit x", 2},
+           {":q!", 3},
+           {":quit", 3},
+           {":se ts=4", 4},
+           {":set ts=4", 4},
+           {":u", 5},
+           {":una x", 6},
+           {":unabbrev x", 6},
+           {":ve", 7},
+           {":xx", std::nullopt},
+           {":", std::nullopt},
+           {"", std::nullopt},
+           {"ab", std::nullopt}})
+    {
+      CAPTURE(command);
+      REQUIRE(index.find(command) == pos);
+    }
+  }
+
+  SECTION("same-as-regex")
+  {
+    // The index should find the same entry as trying all regex in order.
+    for (const auto& command : std::vector<std::string>{
+           ":ab",
+           ":cd x",
+           ":e",
+           ":ee",
+           ":q(",
+           ":s",
+           ":una",
+           ":unax",
+           "x :cd"})
+    {
+      const auto& it = std::ranges::find_if(
+        regex,
+        [&command](const auto& r)
+        {
+          return boost::regex_search(command, boost::regex(r));
+        });
+
+      CAPTURE(command);
+      REQUIRE(
+        index.find(command) ==
+        (it != regex.end() ? std::optional<size_t>(it - regex.begin()) :
+                             std::nullopt));
+    }
+  }
+}
+
+TEST_CASE("wex::command_index-benchmark", "[.benchmark]")
+{
+  const wex::command_index index(regex);
+  const int                max         = 10000;
+  const auto               start_regex = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < max; i++)
+  {
+    REQUIRE(
+      std::ranges::find_if(
+        regex,
+        [](const auto& r)
+        {
+          return boost::regex_search(std::string(":ve"), boost::regex(r));
+        }) != regex.end());
+  }
+
+  const auto milli_regex =
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_regex);
+
+  const auto start_index = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < max; i++)
+  {
+    REQUIRE(index.find(":ve"));
+  }
+
+  const auto milli_index =
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start_index);
+
+  WARN(
+    "command_index: " << max << " finds, regex " << milli_regex.count()
+                      << " ms, index " << milli_index.count() << " ms");
+}
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-ex-stream-index.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/factory/text-window.h>
+
+#include "../src/ex/ex-stream-index.h"
+#include "test.h"
+
+#include <fstream>
+#include <thread>
+#include <vector>
+
+TEST_CASE("wex::ex_stream_index")
+{
+  SECTION("empty")
+  {
+    std::fstream ofs("ex-index.txt", std::ios_base::out);
+    ofs.close();
+
+    wex::ex_stream_index index(wex::path("ex-index.txt"), 100);
+
+    REQUIRE(!index.is_ok());
+    REQUIRE(index.line_begin(0) == std::string::npos);
+    REQUIRE(index.line_count_request() == wex::LINE_COUNT_UNKNOWN);
+  }
+
+  SECTION("lines")
+  {
+    std::fstream ofs("ex-index.txt", std::ios_base::out);
+
+    for (int i = 0; i < 1000; i++)
+    {
+      ofs << "line" << i << "\n";
+    }
+
+    ofs << "last";
+    ofs.close();
+
+    wex::ex_stream_index index(wex::path("ex-index.txt"), 100);
+
+    {
+      // Several threads can wait for the line count at once.
+      std::vector<int>          counts(4);
+      std::vector<std::jthread> threads;
+
+      for (auto& count : counts)
+      {
+        threads.emplace_back(
+          [&index, &count]
+          {
+            count = index.line_count_request();
+          });
+      }
+
+      threads.clear();
+
+      REQUIRE(counts == std::vector<int>(4, 1001));
+    }
+
+    REQUIRE(index.is_ok());
+    REQUIRE(index.line_begin(0) == 0);
+    REQUIRE(index.line_begin(1) == 6);
+    REQUIRE(index.line_no(7) == 1);
+    REQUIRE(index.line_end(0) == 6);
+
+    REQUIRE(index.line_count_request() == 1001);
+    REQUIRE(index.is_complete());
+    REQUIRE(index.line_count() == 1001);
+    REQUIRE(!index.is_block_mode());
+
+    for (int i = 0; i < 1001; i += 7)
+    {
+      const auto begin(index.line_begin(i));
+      REQUIRE(begin != std::string::npos);
+      REQUIRE(index.line_no(begin) == i);
+      REQUIRE(index.line_no(index.line_end(begin) - 1) == i);
+    }
+
+    REQUIRE(index.data().substr(index.line_begin(1000)) == "last");
+    REQUIRE(index.line_begin(1001) == std::string::npos);
+  }
+
+  SECTION("noeol")
+  {
+    std::fstream ofs("ex-index.txt", std::ios_base::out);
+    ofs << std::string(1000, 'x');
+    ofs.close();
+
+    wex::ex_stream_index index(wex::path("ex-index.txt"), 100);
+
+    REQUIRE(index.line_count_request() == 11);
+    REQUIRE(index.is_block_mode());
+    REQUIRE(index.line_begin(1) == 99);
+  }
+
+  remove("ex-index.txt");
+}
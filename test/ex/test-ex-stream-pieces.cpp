@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-ex-stream-pieces.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/factory/text-window.h>
+
+#include "../src/ex/ex-stream-index.h"
+#include "../src/ex/ex-stream-pieces.h"
+#include "test.h"
+
+#include <fstream>
+
+TEST_CASE("wex::ex_stream_pieces")
+{
+  {
+    std::fstream ofs("ex-pieces.txt", std::ios_base::out);
+    ofs << "test1\ntest2\ntest3\ntest4\ntest5";
+  }
+
+  wex::ex_stream_index  index(wex::path("ex-pieces.txt"), 100);
+  wex::ex_stream_pieces pieces(index);
+
+  REQUIRE(pieces.size() == 1);
+  REQUIRE(!pieces.can_undo());
+  REQUIRE(pieces.line_count() == 5);
+
+  char buffer[100];
+
+  SECTION("copy")
+  {
+    REQUIRE(pieces.copy(0, 1, 3));
+    REQUIRE(pieces.line_count() == 7);
+    REQUIRE(
+      pieces.get(0, 6) == "test1\ntest2\ntest3\ntest1\ntest2\ntest4\ntest5");
+
+    // the copied last line gets an eol
+    REQUIRE(pieces.copy(6, 6, 0));
+    REQUIRE(pieces.get(0, 1) == "test5\ntest1\n");
+    REQUIRE(!pieces.copy(0, 1, 100));
+  }
+
+  SECTION("erase")
+  {
+    REQUIRE(pieces.erase(1, 2));
+    REQUIRE(pieces.line_count() == 3);
+    REQUIRE(pieces.get(0, 2) == "test1\ntest4\ntest5");
+    REQUIRE(pieces.line(1, buffer, 100) == 5);
+    REQUIRE(std::string(buffer) == "test4");
+    REQUIRE(!pieces.erase(2, 1));
+  }
+
+  SECTION("find")
+  {
+    const auto search = [](std::string_view v)
+    {
+      return v.find("test4");
+    };
+
+    REQUIRE(pieces.find(0, true, search) == 3);
+    REQUIRE(pieces.find(4, true, search) == wex::LINE_NUMBER_UNKNOWN);
+    REQUIRE(pieces.insert(1, "test4\n"));
+    REQUIRE(pieces.find(0, true, search) == 1);
+    REQUIRE(pieces.find(2, true, search) == 4);
+    REQUIRE(
+      pieces.find(
+        5,
+        false,
+        [](std::string_view v)
+        {
+          return v.rfind("test1");
+        }) == 0);
+    REQUIRE(
+      pieces.find(
+        wex::LINE_NUMBER_UNKNOWN,
+        false,
+        [](std::string_view v)
+        {
+          return v.rfind("test5");
+        }) == 5);
+  }
+
+  SECTION("for_each")
+  {
+    std::string text;
+
+    REQUIRE(pieces.erase(0, 0));
+    REQUIRE(pieces.for_each(
+      2,
+      [&text](std::string_view v)
+      {
+        text += v;
+        return true;
+      }));
+    REQUIRE(text == "test4\ntest5");
+    REQUIRE(!pieces.for_each(10, nullptr));
+  }
+
+  SECTION("insert")
+  {
+    REQUIRE(!pieces.insert(0, std::string()));
+    REQUIRE(pieces.insert(0, "begin\n"));
+    REQUIRE(pieces.insert(3, "middle\n"));
+    REQUIRE(pieces.insert(7, "end\n"));
+    REQUIRE(pieces.line_count() == 8);
+    REQUIRE(
+      pieces.get(0, 7) ==
+      "begin\ntest1\ntest2\nmiddle\ntest3\ntest4\ntest5\nend\n");
+    REQUIRE(pieces.line(3, buffer, 100) == 6);
+    REQUIRE(std::string(buffer) == "middle");
+  }
+
+  SECTION("line")
+  {
+    REQUIRE(pieces.line(0, buffer, 100) == 5);
+    REQUIRE(std::string(buffer) == "test1");
+    REQUIRE(pieces.line(4, buffer, 100) == 5);
+    REQUIRE(std::string(buffer) == "test5");
+    REQUIRE(pieces.line(4, buffer, 3) == 2);
+    REQUIRE(std::string(buffer) == "te");
+    REQUIRE(pieces.line(5, buffer, 100) == std::string::npos);
+  }
+
+  SECTION("move")
+  {
+    REQUIRE(!pieces.move(0, 1, 1));
+    REQUIRE(pieces.move(0, 1, 4));
+    REQUIRE(pieces.line_count() == 5);
+    REQUIRE(pieces.get(0, 4) == "test3\ntest4\ntest1\ntest2\ntest5");
+    REQUIRE(pieces.move(3, 4, 0));
+    REQUIRE(pieces.get(0, 4) == "test2\ntest5\ntest3\ntest4\ntest1\n");
+  }
+
+  SECTION("replace")
+  {
+    REQUIRE(pieces.replace(1, 3, "x\n"));
+    REQUIRE(pieces.line_count() == 3);
+    REQUIRE(pieces.get(0, 2) == "test1\nx\ntest5");
+    REQUIRE(pieces.replace(0, 0, std::string()));
+    REQUIRE(pieces.get(0, 1) == "x\ntest5");
+  }
+
+  SECTION("undo")
+  {
+    REQUIRE(!pieces.undo());
+    REQUIRE(pieces.erase(0, 1));
+    REQUIRE(pieces.insert(0, "x\n"));
+    REQUIRE(pieces.can_undo());
+    REQUIRE(pieces.undo());
+    REQUIRE(pieces.get(0, 2) == "test3\ntest4\ntest5");
+    REQUIRE(pieces.undo());
+    REQUIRE(!pieces.can_undo());
+    REQUIRE(pieces.get(0, 4) == "test1\ntest2\ntest3\ntest4\ntest5");
+  }
+
+  remove("ex-pieces.txt");
+}
@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-ex-stream-scan.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/core/file.h>
+#include <wex/ex/addressrange.h>
+#include <wex/ex/ex.h>
+
+#include "../src/ex/ex-stream-line.h"
+#include "../src/ex/ex-stream-scan.h"
+#include "test.h"
+
+TEST_CASE("wex::ex_stream_scan")
+{
+  auto* stc = get_stc();
+  stc->set_text("\n\n\n\n\n\n");
+  wex::ex ex(stc, wex::ex::mode_t::EX);
+
+  const std::string text("test1\ntest2\ntest3\ntest4\n\n");
+
+  SECTION("blocks")
+  {
+    const wex::addressrange ar(&ex, "2,3");
+
+    for (size_t size = 1; size <= text.size(); size++)
+    {
+      wex::ex_stream_line sl(nullptr, wex::ex_stream_line::ACTION_GET, ar);
+      wex::ex_stream_scan scan(sl, 100);
+
+      for (size_t i = 0; i < text.size(); i += size)
+      {
+        scan.feed(std::span{text.data() + i, std::min(size, text.size() - i)});
+      }
+
+      scan.finish();
+
+      REQUIRE(sl.copy() == "test2\ntest3\n");
+    }
+  }
+
+  SECTION("copy-rest")
+  {
+    const wex::addressrange ar(&ex, "1,2");
+
+    {
+      wex::file           file("ex-scan.txt", std::ios_base::out);
+      wex::ex_stream_line sl(&file, wex::ex_stream_line::ACTION_ERASE, ar);
+      wex::ex_stream_scan scan(sl, 100);
+
+      REQUIRE(scan.feed(text));
+      REQUIRE(scan.is_copy_rest());
+      scan.finish();
+
+      REQUIRE(sl.actions() == 2);
+      REQUIRE(sl.lines() == 6);
+    }
+
+    wex::file file("ex-scan.txt");
+    REQUIRE(*file.read() == "test3\ntest4\n\n");
+  }
+
+  SECTION("max-line-size")
+  {
+    const wex::addressrange ar(&ex, "1,3");
+
+    wex::ex_stream_line sl(nullptr, wex::ex_stream_line::ACTION_GET, ar);
+    wex::ex_stream_scan scan(sl, 3);
+
+    REQUIRE(!scan.feed(text));
+    REQUIRE(!scan.feed(text));
+    scan.finish();
+
+    REQUIRE(sl.copy() == "test1\ntes");
+  }
+
+  remove("ex-scan.txt");
+}
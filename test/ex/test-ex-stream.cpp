@@ -181,6 +181,21 @@ TEST_CASE("wex::ex_stream")
       REQUIRE(exs.is_modified());
       REQUIRE(*exs.get_work() == "123456781\n123456782\ntest3\ntest4\n\n");
     }
+
+    SECTION("undo")
+    {
+      REQUIRE(!exs.undo());
+
+      const wex::addressrange ar(&ex, "1,2");
+
+      REQUIRE(exs.erase(ar));
+      REQUIRE(exs.get_line_count_request() == 3);
+      REQUIRE(exs.undo());
+      REQUIRE(!exs.is_modified());
+      REQUIRE(exs.get_line_count_request() == 5);
+      REQUIRE(*exs.get_work() == "test1\ntest2\ntest3\ntest4\n\n");
+      REQUIRE(!exs.undo());
+    }
   }
 
   // See also stc/test-ex-mocde.cpp
@@ -352,6 +367,13 @@ TEST_CASE("wex::ex_stream")
 
     const wex::addressrange ar(&ex, "%");
     REQUIRE(exs.write(ar, "tmp.txt"));
+
+    // Writing into the file itself, the stream is no longer modified.
+    REQUIRE(exs.erase(wex::addressrange(&ex, "1,2")));
+    REQUIRE(exs.is_modified());
+    REQUIRE(exs.write(wex::addressrange(&ex, "%"), "ex-mode.txt"));
+    REQUIRE(!exs.is_modified());
+    REQUIRE(exs.get_line_count_request() == 3);
   }
 
   SECTION("yank")
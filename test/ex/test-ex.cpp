@@ -14,6 +14,9 @@
 #include "test-defs.h"
 #include "test.h"
 
+#include <algorithm>
+#include <chrono>
+
 // See stc/test-vi.cpp and test-ex-mode for testing goto and :set
 
 TEST_CASE("wex::ex")
@@ -509,3 +512,29 @@ TEST_CASE("wex::ex")
     REQUIRE(!ex->command(":1,5yankc"));
   }
 }
+
+TEST_CASE("wex::ex-benchmark", "[.benchmark]")
+{
+  auto* stc = new wex::test::stc();
+  stc->visual(true);
+  auto* ex = new wex::ex(stc);
+
+  const wex::path p("test.h");
+  ALLOW_CALL(*stc, path()).RETURN(p);
+
+  const int  max   = 10000;
+  const auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < max; i++)
+  {
+    REQUIRE(ex->command(":una xyz"));
+  }
+
+  const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  WARN(
+    "ex: " << max << " commands in " << milli.count() << " ms, "
+           << max * 1000 / std::max<long>(milli.count(), 1)
+           << " commands/s");
+}
@@ -196,6 +196,21 @@ TEST_CASE("wex::macros", "[!mayfail]")
     REQUIRE(macros.get_register('_').empty());
   }
 
+  SECTION("registers-save")
+  {
+    REQUIRE(!macros.is_modified());
+    REQUIRE(macros.set_register('y', "hello y"));
+    REQUIRE(macros.set_register('Y', " and more"));
+    REQUIRE(macros.is_modified());
+    REQUIRE(macros.find("y").size() == 1);
+    REQUIRE(macros.get_register('y') == "hello y and more");
+
+    // The registers are saved with the document.
+    REQUIRE(macros.save_document());
+    REQUIRE(!macros.is_modified());
+    REQUIRE(!macros.save_document());
+  }
+
   // Test input macro variables (requires input).
   // Test template macro variables (requires input).
 
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-process-output.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../src/factory/process-output.h"
+
+#include <wex/test/test.h>
+
+TEST_CASE("wex::factory::process_output")
+{
+  std::string              blocks;
+  std::vector<std::string> lines;
+
+  SECTION("block")
+  {
+    wex::factory::process_output output(
+      [&blocks](const std::string& text)
+      {
+        blocks += text;
+      },
+      nullptr,
+      10,
+      std::chrono::milliseconds(1000));
+
+    output.append("hello");
+    REQUIRE(blocks.empty());
+    REQUIRE(output.blocks() == 0);
+
+    output.append(" world\n");
+    REQUIRE(blocks == "hello world\n");
+    REQUIRE(output.blocks() == 1);
+
+    output.append("xx");
+    REQUIRE(blocks == "hello world\n");
+
+    output.flush();
+    REQUIRE(blocks == "hello world\nxx");
+    REQUIRE(output.blocks() == 2);
+
+    output.flush();
+    REQUIRE(output.blocks() == 2);
+  }
+
+  SECTION("flush_on_time")
+  {
+    std::mutex                   mutex;
+    wex::factory::process_output output(
+      [&blocks, &mutex](const std::string& text)
+      {
+        std::lock_guard lock(mutex);
+        blocks += text;
+      },
+      nullptr,
+      1000,
+      std::chrono::milliseconds(10));
+
+    std::jthread flusher(
+      [&output](std::stop_token st)
+      {
+        output.flush_on_time(st);
+      });
+
+    output.append("prompt>");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    flusher.request_stop();
+    flusher.join();
+
+    REQUIRE(blocks == "prompt>");
+    REQUIRE(output.blocks() == 1);
+  }
+
+  SECTION("line")
+  {
+    wex::factory::process_output output(
+      [&blocks](const std::string& text)
+      {
+        blocks += text;
+      },
+      [&lines](const std::string& text)
+      {
+        lines.emplace_back(text);
+      });
+
+    output.append("first\nsec");
+    output.append("ond\nthird");
+    output.flush();
+
+    REQUIRE(blocks == "first\nsecond\nthird");
+    REQUIRE(lines.size() == 2);
+    REQUIRE(lines.front() == "first\n");
+    REQUIRE(lines.back() == "second\n");
+  }
+
+  SECTION("max_word")
+  {
+    wex::factory::process_output output(
+      [&blocks](const std::string& text)
+      {
+        blocks += text;
+      },
+      [&lines](const std::string& text)
+      {
+        lines.emplace_back(text);
+      },
+      1000,
+      std::chrono::milliseconds(1000),
+      5);
+
+    output.append("12345");
+    output.append("678 9\nab");
+    output.append("cdefgh\nxyz\n");
+    output.append("a long line with short words\n");
+    output.flush();
+
+    REQUIRE(
+      blocks ==
+      "12345...\nabcde...\nxyz\na long line with short words\n");
+    REQUIRE(lines.size() == 4);
+    REQUIRE(lines.front() == "12345...\n");
+  }
+}
+
+TEST_CASE("wex::factory::process_output-benchmark", "[.benchmark]")
+{
+  const std::string line(std::string(79, 'x') + "\n");
+  std::string       chunk;
+
+  while (chunk.size() < 4096)
+  {
+    chunk += line;
+  }
+
+  const size_t                 total = 64 * 1024 * 1024;
+  size_t                       received{0};
+  wex::factory::process_output output(
+    [&received](const std::string& text)
+    {
+      received += text.size();
+    });
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (size_t i = 0; i < total; i += chunk.size())
+  {
+    output.append(chunk);
+  }
+
+  output.flush();
+
+  const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+
+  const auto mb = total / (1024.0 * 1024.0);
+
+  WARN(
+    "process_output: " << mb << " MB in " << milli.count() << " ms, "
+                       << mb * 1000 / std::max<long>(milli.count(), 1)
+                       << " MB/s");
+
+  REQUIRE(received >= total);
+  REQUIRE(output.blocks() < received / 4096);
+}
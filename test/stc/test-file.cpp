@@ -5,8 +5,14 @@
 // Copyright: (c) 2021-2022 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <wex/core/config.h>
 #include <wex/stc/file.h>
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
 #include "test.h"
 
 TEST_CASE("wex::stc_file")
@@ -31,4 +37,97 @@ TEST_CASE("wex::stc_file")
   REQUIRE(file.file_save());
   REQUIRE(!file.is_contents_changed());
   REQUIRE(remove("test-file.txt") == 0);
+
+  SECTION("load-async")
+  {
+    std::string text;
+    while (text.size() < 1000000)
+    {
+      text += "No, the game never ends when your whole world depends\n";
+    }
+
+    std::ofstream("test-file-large.txt") << text;
+
+    auto* large = new wex::stc();
+    frame()->pane_add(large);
+
+    REQUIRE(large->get_file().file_load(wex::path("test-file-large.txt")));
+
+    // The first part is shown at once.
+    REQUIRE(large->GetLength() > 0);
+
+    for (int i = 0; i < 500 && large->GetLength() < (int)text.size(); i++)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      wxTheApp->ProcessPendingEvents();
+    }
+
+    REQUIRE(large->GetLength() == (int)text.size());
+    REQUIRE(remove("test-file-large.txt") == 0);
+  }
+
+  SECTION("follow")
+  {
+    const wex::path p("test-file-follow.log");
+
+    std::string text;
+    while (text.size() < 2000)
+    {
+      text += "a line of a log file\n";
+    }
+
+    std::ofstream(p.data()) << text;
+
+    auto* tail = new wex::stc();
+    frame()->pane_add(tail);
+
+    REQUIRE(tail->get_file().file_load(p));
+    wxTheApp->ProcessPendingEvents();
+    REQUIRE(tail->GetLength() == (int)text.size());
+
+    // The modification time is in seconds, so touch the file.
+    const auto touch = [&p](int seconds)
+    {
+      std::filesystem::last_write_time(
+        p.data(),
+        std::filesystem::file_time_type::clock::now() +
+          std::chrono::seconds(seconds));
+    };
+
+    // Only the appended text is read.
+    std::ofstream(p.data(), std::ios_base::app) << "appended\n";
+    touch(2);
+    REQUIRE(tail->get_file().check_sync());
+    wxTheApp->ProcessPendingEvents();
+    REQUIRE(tail->GetLength() == (int)text.size() + 9);
+    REQUIRE(tail->get_text().ends_with("a line of a log file\nappended\n"));
+
+    // The first lines are dropped.
+    wex::config("stc.max.Lines follow").set(10);
+    std::ofstream(p.data(), std::ios_base::app) << "more\n";
+    touch(4);
+    REQUIRE(tail->get_file().check_sync());
+    wxTheApp->ProcessPendingEvents();
+    REQUIRE(tail->GetLineCount() == 10);
+    REQUIRE(tail->get_text().ends_with("appended\nmore\n"));
+    wex::config("stc.max.Lines follow").set(0);
+
+    // A truncated file is loaded completely.
+    std::ofstream(p.data()) << text.substr(0, 1500);
+    touch(6);
+    REQUIRE(tail->get_file().check_sync());
+    wxTheApp->ProcessPendingEvents();
+    REQUIRE(tail->GetLength() == 1500);
+
+    // A rotated file is loaded completely.
+    std::filesystem::rename(p.data(), p.string() + ".1");
+    std::ofstream(p.data()) << text << "rotated\n";
+    touch(8);
+    REQUIRE(tail->get_file().check_sync());
+    wxTheApp->ProcessPendingEvents();
+    REQUIRE(tail->get_text() == text + "rotated\n");
+
+    REQUIRE(remove(p.string().c_str()) == 0);
+    REQUIRE(remove((p.string() + ".1").c_str()) == 0);
+  }
 }
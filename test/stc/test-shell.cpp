@@ -5,10 +5,14 @@
 // Copyright: (c) 2021 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <wex/factory/defs.h>
 #include <wex/stc/shell.h>
 
 #include "test.h"
 
+#include <algorithm>
+#include <chrono>
+
 /// Processes string on shell.
 void process(const std::string& str, wex::shell* shell);
 
@@ -20,6 +24,21 @@ void process(const std::string& str, wex::shell* shell)
   }
 }
 
+/// Appends blocks as process output to shell.
+void append_blocks(wex::shell* shell, const std::string& block, int blocks);
+
+void append_blocks(wex::shell* shell, const std::string& block, int blocks)
+{
+  for (int i = 0; i < blocks; i++)
+  {
+    wxCommandEvent append(wxEVT_COMMAND_MENU_SELECTED, wex::ID_SHELL_APPEND);
+    append.SetString(block);
+    wxPostEvent(shell, append);
+  }
+
+  wxTheApp->ProcessPendingEvents();
+}
+
 TEST_CASE("wex::shell")
 {
   auto* shell = new wex::shell();
@@ -95,6 +114,11 @@ TEST_CASE("wex::shell")
 
   shell->set_process(nullptr);
 
+  // Test appending process output into the shell, as coalesced blocks.
+  shell->SetText("");
+  append_blocks(shell, std::string(1023, 'x') + "\n", 4);
+  REQUIRE(shell->GetLineCount() >= 4);
+
   shell->DocumentEnd();
 
   wxKeyEvent event(wxEVT_KEY_DOWN);
@@ -107,3 +131,28 @@ TEST_CASE("wex::shell")
     wxTheApp->ProcessPendingEvents();
   }
 }
+
+TEST_CASE("wex::shell-benchmark", "[.benchmark]")
+{
+  auto* shell = new wex::shell();
+  frame()->pane_add(shell);
+
+  shell->set_process(nullptr);
+
+  const std::string block(std::string(64 * 1024 - 1, 'x') + "\n");
+  const int         blocks = 64;
+  const auto        start  = std::chrono::steady_clock::now();
+
+  append_blocks(shell, block, blocks);
+
+  const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start);
+  const auto mb = blocks * block.size() / (1024.0 * 1024.0);
+
+  WARN(
+    "shell append: " << mb << " MB in " << milli.count() << " ms, "
+                     << mb * 1000 / std::max<long>(milli.count(), 1)
+                     << " MB/s");
+
+  REQUIRE(shell->GetLineCount() >= blocks);
+}
@@ -74,6 +74,59 @@ TEST_CASE("wex::blame")
     REQUIRE(!blame.info().contains("A unknown user"));
   }
 
+  SECTION("stream")
+  {
+    pugi::xml_document doc;
+
+    // clang-format off
+    REQUIRE(doc.load_string(
+      "<vcs name=\"git\" "
+      "blame-format=\"(^[a-zA-Z0-9]+) (.*)\\(([a-zA-Z "
+      "]+)\\s+([0-9]{2,4}.[0-9]{2}.[0-9]{2}.[0-9:]{8}) .[0-9]+\\s+([0-9]+)\\) (.*)\" "
+      "date-format=\"%Y-%m-%d %H:%M:%S\" "
+      "date-print=\"10\" >"
+      "</vcs>"));
+    // clang-format on
+
+    wex::blame blame(doc.document_element());
+
+    const std::string text(
+      "bf5d87cc src/http_travel.cpp (A unknown user 2019-02-01 12:20:06 +0100 "
+      "15) first\n"
+      "bf5d87cc src/http_travel.cpp (A unknown user 2019-02-01 12:20:06 +0100 "
+      "16) second\r\n"
+      "bf5d87cc src/http_travel.cpp (A unknown user 2019-02-01 12:20:06 +0100 "
+      "17) third");
+
+    std::vector<std::string> lines;
+
+    const auto parsed = [&lines](wex::blame& b)
+    {
+      REQUIRE(b.style() == wex::blame::margin_style_t::OTHER);
+      lines.emplace_back(std::to_string(b.line_no()) + b.line_text());
+    };
+
+    blame.stream_begin(wex::path());
+
+    // The chunks end within a line.
+    REQUIRE(blame.stream(text.substr(0, 40), parsed) == 0);
+    REQUIRE(blame.stream(text.substr(40, 100), parsed) == 1);
+    REQUIRE(blame.stream(text.substr(140), parsed) == 1);
+    REQUIRE(blame.stream_end(parsed) == 1);
+    REQUIRE(blame.stream_end(parsed) == 0);
+
+    REQUIRE(
+      lines == std::vector<std::string>{"14first", "15second", "16third"});
+
+    // A copy parses using its own regex.
+    wex::blame copy(blame);
+    REQUIRE(copy.parse(wex::path(), text.substr(0, text.find('\n'))));
+    REQUIRE(blame.parse(wex::path(), text.substr(text.rfind('\n') + 1)));
+    REQUIRE(copy.line_no() == 14);
+    REQUIRE(copy.line_text() == "first");
+    REQUIRE(blame.line_no() == 16);
+  }
+
   SECTION("set")
   {
     wex::blame blame;
@@ -160,6 +160,32 @@ TEST_CASE("wex::lexer")
     REQUIRE(lexer.attrib(_("Edge line")) == -1);
   }
 
+  SECTION("colourise")
+  {
+    auto*      stc = new wex::test::stc();
+    wex::lexer l(stc);
+    REQUIRE(!l.colourise());
+    REQUIRE(l.colourised() == 1);
+
+    std::string text;
+    while (text.size() < 1000000)
+    {
+      text += "int main() { return 0; } // comment\n";
+    }
+
+    stc->SetText(text);
+    REQUIRE(l.set("cpp"));
+    REQUIRE(l.colourised() > 0);
+
+    while (l.colourise())
+    {
+      ;
+    }
+
+    REQUIRE(l.colourised() == 1);
+    REQUIRE(!l.colourise());
+  }
+
   SECTION("comment_complete")
   {
     REQUIRE(lexer.set("pascal"));
@@ -2,14 +2,17 @@
 // Name:      test-lexers.cpp
 // Purpose:   Implementation for wex unit testing
 // Author:    Anton van Wezenbeek
-// Copyright: (c) 2021-2025 Anton van Wezenbeek
+// Copyright: (c) 2021-2026 Anton van Wezenbeek
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <wex/core/core.h>
 #include <wex/syntax/lexers.h>
 #include <wex/test/test.h>
 
 #include "test.h"
 
+#include <algorithm>
+
 // see also test-stc
 
 TEST_CASE("wex::lexers")
@@ -116,6 +119,45 @@ TEST_CASE("wex::lexers")
     }
   }
 
+  SECTION("find_by_filename")
+  {
+    const auto& lexers(wex::lexers::get()->get_lexers());
+
+    // The index finds the same lexer as matching the lexers in order.
+    for (const std::string filename : {
+           "CMakeLists.txt",
+           "Makefile",
+           "README.md",
+           "test.cpp",
+           "test.h",
+           "test.hpp",
+           "test.py",
+           "test.sh",
+           "test.xml",
+           "test.json",
+           "test.txt",
+           "test.log",
+           "test.cmake",
+           ".bashrc",
+           "no-extension",
+           "test.xxx"})
+    {
+      const auto& it = std::ranges::find_if(
+        lexers,
+        [&filename](const auto& l)
+        {
+          return !l.extensions().empty() &&
+                 wex::matches_one_of(filename, l.extensions());
+        });
+
+      CAPTURE(filename);
+      REQUIRE(
+        wex::lexers::get()->find_by_filename(filename).display_lexer() ==
+        (it != lexers.end() ? it->display_lexer() :
+                              lexers.front().display_lexer()));
+    }
+  }
+
   SECTION("keywords")
   {
     REQUIRE(!wex::lexers::get()->keywords("cpp").empty());
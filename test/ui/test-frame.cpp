@@ -57,6 +57,14 @@ TEST_CASE("wex::frame")
     REQUIRE(!frame()->update_statusbar(get_stc(), "Pane1"));
     REQUIRE(frame()->update_statusbar(get_stc(), "PaneInfo"));
 
+    get_stc()->set_text("line1\nline2\nline3\n");
+    get_stc()->SetSelection(0, 14);
+    REQUIRE(frame()->update_statusbar(get_stc(), "PaneInfo"));
+    REQUIRE(frame()->get_statustext("PaneInfo") == "3,3,14");
+    get_stc()->SetSelection(0, 3);
+    REQUIRE(frame()->update_statusbar(get_stc(), "PaneInfo"));
+    REQUIRE(frame()->get_statustext("PaneInfo") == "1,4,3");
+
     auto* lv = new wxListView(frame());
     lv->Show();
     REQUIRE(frame()->update_statusbar(lv));
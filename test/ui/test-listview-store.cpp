@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-listview-store.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/ui/listview-store.h>
+
+#include <chrono>
+
+#include "test.h"
+
+TEST_CASE("wex::listview_store")
+{
+  wex::listview_store store;
+
+  store.append_column(wex::column::STRING_MEDIUM);
+  store.append_column(wex::column::INT);
+  store.append_column(wex::column::FLOAT);
+
+  SECTION("constructor")
+  {
+    REQUIRE(store.columns() == 3);
+    REQUIRE(store.size() == 0);
+    REQUIRE(store.get(0, 0).empty());
+    REQUIRE(!store.get_number(0, 1));
+  }
+
+  SECTION("insert")
+  {
+    REQUIRE(store.insert({"x", "1", "1.50"}));
+    REQUIRE(store.insert({"y"}));
+    REQUIRE(store.insert({"w", "-7"}, 0));
+    REQUIRE(!store.insert({"a", "b", "c", "d"}));
+    REQUIRE(store.size() == 3);
+
+    REQUIRE(store.get(0, 0) == "w");
+    REQUIRE(store.get(1, 0) == "x");
+    REQUIRE(store.get(1, 2) == "1.50");
+    REQUIRE(store.get(2, 1).empty());
+    REQUIRE(store.get(3, 0).empty());
+    REQUIRE(store.get(0, 3).empty());
+
+    REQUIRE(*store.get_number(0, 1) == -7);
+    REQUIRE(!store.get_number(2, 1));
+    REQUIRE(!store.get_number(1, 2));
+
+    REQUIRE(store.is_equal(1, 0, "x"));
+    REQUIRE(store.is_equal(0, 1, "-7"));
+    REQUIRE(store.is_equal(2, 1, ""));
+    REQUIRE(!store.is_equal(1, 0, "y"));
+    REQUIRE(!store.is_equal(3, 0, ""));
+  }
+
+  SECTION("numbers-as-text")
+  {
+    // A text that is not the number as string is kept as is.
+    REQUIRE(store.insert({"x", "12"}));
+    REQUIRE(store.insert({"y", "007"}));
+
+    REQUIRE(store.get(0, 1) == "12");
+    REQUIRE(store.get(1, 1) == "007");
+    REQUIRE(!store.get_number(0, 1));
+
+    store.clear();
+    REQUIRE(store.insert({"x", "12"}));
+    REQUIRE(*store.get_number(0, 1) == 12);
+  }
+
+  SECTION("set-erase")
+  {
+    REQUIRE(store.insert({"x", "1"}));
+    REQUIRE(store.insert({"x", "2"}));
+
+    store.set(1, 0, "z");
+    store.set(1, 1, "+5");
+    store.set(5, 0, "ignored");
+    REQUIRE(store.get(0, 0) == "x");
+    REQUIRE(store.get(1, 0) == "z");
+    REQUIRE(store.get(0, 1) == "1");
+    REQUIRE(store.get(1, 1) == "+5");
+
+    store.erase(0);
+    REQUIRE(store.size() == 1);
+    REQUIRE(store.get(0, 0) == "z");
+
+    store.clear();
+    REQUIRE(store.size() == 0);
+    REQUIRE(store.columns() == 3);
+  }
+
+  SECTION("reorder")
+  {
+    REQUIRE(store.insert({"a", "1"}));
+    REQUIRE(store.insert({"b", "2"}));
+    REQUIRE(store.insert({"c", "3"}));
+
+    store.reorder({2, 0, 1});
+    REQUIRE(store.get(0, 0) == "c");
+    REQUIRE(store.get(1, 0) == "a");
+    REQUIRE(store.get(2, 0) == "b");
+    REQUIRE(*store.get_number(0, 1) == 3);
+
+    // A wrong size is ignored.
+    store.reorder({0});
+    REQUIRE(store.get(0, 0) == "c");
+  }
+
+  SECTION("append_column")
+  {
+    REQUIRE(store.insert({"a", "1"}));
+    store.append_column(wex::column::STRING_SMALL);
+    REQUIRE(store.insert({"b", "2", "", "x"}));
+
+    REQUIRE(store.get(0, 3).empty());
+    REQUIRE(store.get(1, 3) == "x");
+  }
+
+  SECTION("benchmark")
+  {
+    // Like find results, many matches in the same file.
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < 500000; i++)
+    {
+      store.insert(
+        {"file" + std::to_string(i / 100) + ".cpp",
+         std::to_string(i % 1000),
+         "  some line with a match"});
+    }
+
+    const auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+
+    CAPTURE(milli.count());
+    REQUIRE(store.size() == 500000);
+    REQUIRE(store.get(499999, 0) == "file4999.cpp");
+    REQUIRE(*store.get_number(499999, 1) == 999);
+  }
+}
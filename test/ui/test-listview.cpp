@@ -197,15 +197,23 @@ TEST_CASE("wex::listview")
     REQUIRE(lv->get_item_text(0, "Int") == "9");
     REQUIRE(lv->get_item_text(1, "Int") == "8");
     REQUIRE(lv->sort_column("Date"));
+    REQUIRE(lv->sort_column("Float", wex::SORT_DESCENDING));
+    REQUIRE(lv->get_item_text(0, "Float") == "4.500000");
+    REQUIRE(lv->get_item_text(0, "Int") == "9");
     REQUIRE(lv->sort_column("Float"));
+    REQUIRE(lv->get_item_text(0, "Float") == "0.000000");
     REQUIRE(lv->sort_column("String"));
 
     REQUIRE(lv->sorted_column_no() == 3);
     lv->sort_column_reset();
     REQUIRE(lv->sorted_column_no() == -1);
 
+    // An incorrect date is sorted first, as an empty text.
     lv->SetItem(0, 1, "incorrect date");
-    REQUIRE(lv->sort_column("Date"));
+    REQUIRE(lv->sort_column("Date", wex::SORT_ASCENDING));
+    REQUIRE(lv->get_item_text(0, "Date") == "incorrect date");
+    REQUIRE(lv->sort_column("Date", wex::SORT_DESCENDING));
+    REQUIRE(lv->get_item_text(0, "Date") == "incorrect date");
   }
 
   SECTION("TSV")
@@ -223,4 +231,50 @@ TEST_CASE("wex::listview")
     auto save(lv->save());
     REQUIRE(save.front() == "x\ty\tz");
   }
+
+  SECTION("owner-data")
+  {
+    auto* lv = new wex::listview(wex::data::listview()
+                                   .type(wex::data::listview::FIND)
+                                   .owner_data(true));
+    frame()->pane_add(lv);
+
+    REQUIRE(lv->data().owner_data());
+    REQUIRE(lv->HasFlag(wxLC_VIRTUAL));
+
+    for (const auto no : std::vector<size_t>{20, 4, 11})
+    {
+      wxCommandEvent event(wxEVT_MENU, wex::ID_LIST_MATCH);
+      event.SetClientData(new wex::path_match(
+        wex::test::get_path("test.h"),
+        wex::tool(wex::ID_TOOL_REPORT_FIND),
+        "a line with a match",
+        no,
+        0));
+      lv->ProcessWindowEvent(event);
+    }
+
+    REQUIRE(lv->GetItemCount() == 3);
+    REQUIRE(lv->get_item_text(0) == "test.h");
+    REQUIRE(lv->get_item_text(2, _("File Name")) == "test.h");
+    REQUIRE(lv->get_item_text(2, _("Line No")) == "12");
+    REQUIRE(!lv->get_item_text(2, _("In Folder")).empty());
+
+    REQUIRE(lv->sort_column(_("Line No"), wex::SORT_ASCENDING));
+    REQUIRE(lv->get_item_text(0, _("Line No")) == "5");
+    REQUIRE(lv->get_item_text(2, _("Line No")) == "21");
+
+    REQUIRE(lv->set_item(0, lv->find_column(_("Match")), "other"));
+    REQUIRE(lv->find_next("other"));
+    REQUIRE(lv->GetFirstSelected() == 0);
+
+    const auto save(lv->save());
+    REQUIRE(save.size() == 3);
+    REQUIRE(lv->load(save));
+    REQUIRE(lv->GetItemCount() == 3);
+    REQUIRE(lv->item_to_text(1) == save[1]);
+
+    lv->clear();
+    REQUIRE(lv->GetItemCount() == 0);
+  }
 }
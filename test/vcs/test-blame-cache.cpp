@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+// Name:      test-blame-cache.cpp
+// Purpose:   Implementation for wex unit testing
+// Author:    Anton van Wezenbeek
+// Copyright: (c) 2026 Anton van Wezenbeek
+////////////////////////////////////////////////////////////////////////////////
+
+#include <wex/vcs/blame-cache.h>
+
+#include "test.h"
+
+TEST_CASE("wex::blame_cache")
+{
+  const std::string a(40, 'a'), b(40, 'b'), z(40, '0');
+
+  const std::string porcelain(
+    a + " 1 1 2\n" +
+    "author Anton\n"
+    "author-mail <anton@x.com>\n"
+    "author-time 1700000000\n"
+    "author-tz +0100\n"
+    "committer Anton\n"
+    "summary first commit\n"
+    "filename test.h\n"
+    "\tline 1\n" +
+    a + " 2 2\n" +
+    "\tline 2\n" +
+    b + " 5 3 1\n" +
+    "author Other\n"
+    "author-time 1700086400\n"
+    "author-tz -0500\n"
+    "summary second commit\n"
+    "previous " +
+    a + " test.h\n" + "filename test.h\n" + "\tline 3\n" + z + " 3 4 1\n" +
+    "author Not Committed Yet\n"
+    "author-time 1700090000\n"
+    "author-tz +0000\n"
+    "summary Version of test.h from test.h\n"
+    "filename test.h\n"
+    "\tline 4\n");
+
+  SECTION("parse")
+  {
+    const auto& blamed(wex::blame_cache::parse(porcelain));
+
+    REQUIRE(blamed.commits.size() == 3);
+    REQUIRE(blamed.lines == std::vector<uint32_t>{0, 0, 1, 2});
+
+    const auto& c(blamed.commits[0]);
+    REQUIRE(c.id == a);
+    REQUIRE(c.author == "Anton");
+    REQUIRE(c.summary == "first commit");
+    REQUIRE(c.time == 1700000000);
+    REQUIRE(c.tz == 3600);
+    REQUIRE(blamed.commits[1].tz == -5 * 3600);
+
+    REQUIRE(wex::blame_cache::parse(std::string()).lines.empty());
+    REQUIRE(wex::blame_cache::parse("xxx\n").lines.empty());
+  }
+
+  SECTION("format")
+  {
+    const auto& blamed(wex::blame_cache::parse(porcelain));
+    const auto& c(blamed.commits[0]);
+
+    REQUIRE(wex::blame_cache::format(c, "%an") == "Anton");
+    REQUIRE(wex::blame_cache::format(c, "%ad") == "2023-11-14");
+    REQUIRE(wex::blame_cache::format(c, "%s") == "first commit");
+    REQUIRE(wex::blame_cache::format(c, "%h %an") == "aaaaaaa Anton");
+    REQUIRE(wex::blame_cache::format(c, "%x %") == "%x %");
+  }
+
+  SECTION("find")
+  {
+    wex::blame_cache cache;
+
+    REQUIRE(!cache.find(wex::path("xxx"), 0));
+    REQUIRE(!cache.find(wex::path("test.h"), -1));
+  }
+}